@@ -0,0 +1,119 @@
+#pragma once
+
+#include "timer_wheel.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace LicenseChain {
+
+class CancellationSource;
+
+// Read side of a cancellation: cheap to copy and pass down through
+// retries, pagination and transport. A default-constructed token is never
+// cancelled and has no deadline.
+//
+// A token is cancelled once its source calls cancel() or its deadline has
+// passed. Long-running work polls isCancelled(); resources that block
+// (a socket, a pooled connection) register onCancel() to be released the
+// moment cancellation happens. Deadline callbacks fire only when the source
+// was armed with cancelAfter() on a TimerWheel; otherwise a passed deadline
+// is noticed by polling.
+class CancellationToken {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    CancellationToken() = default;
+
+    bool isCancelled() const;
+    bool hasDeadline() const;
+    Clock::time_point deadline() const;
+    // Time left before the deadline; Clock::duration::max() without one.
+    Clock::duration remaining() const;
+
+    // CancelledException or DeadlineExceededException; null if not cancelled.
+    std::exception_ptr error() const;
+    void throwIfCancelled() const;
+
+    // Runs `callback` once when the token is cancelled, immediately if it
+    // already is. Returns an id for removeCallback(), or 0 if it ran inline
+    // or the token can never be cancelled.
+    uint64_t onCancel(std::function<void()> callback) const;
+    void removeCallback(uint64_t id) const;
+
+private:
+    friend class CancellationSource;
+
+    enum class Reason : int { None, Cancelled, DeadlineExceeded };
+
+    struct State {
+        ~State();
+
+        std::atomic<int> reason{static_cast<int>(Reason::None)};
+        std::atomic<Clock::rep> deadline{Clock::time_point::max().time_since_epoch().count()};
+        std::mutex mutex;
+        std::vector<std::pair<uint64_t, std::function<void()>>> callbacks;
+        uint64_t next_id = 1;
+        // Link to a parent token, removed again when this state goes away.
+        std::shared_ptr<State> parent;
+        uint64_t parent_callback = 0;
+        uint64_t timer = 0;
+        TimerWheel* timers = nullptr;
+
+        void cancel(Reason why);
+    };
+
+    explicit CancellationToken(std::shared_ptr<State> state) : state_(std::move(state)) {}
+
+    std::shared_ptr<State> state_;
+};
+
+// Write side: owns a cancellation and hands out tokens for it.
+class CancellationSource {
+public:
+    using Clock = CancellationToken::Clock;
+
+    CancellationSource();
+    explicit CancellationSource(Clock::time_point deadline);
+    // Linked to `parent`: cancelled when it is, and never outlives its deadline.
+    explicit CancellationSource(const CancellationToken& parent,
+                                Clock::time_point deadline = Clock::time_point::max());
+
+    CancellationToken token() const { return CancellationToken(state_); }
+    void cancel();
+    bool isCancelled() const { return token().isCancelled(); }
+
+    // Sets the deadline to now + timeout (if earlier) and arms a timer so
+    // onCancel() callbacks fire when it passes. The wheel must outlive the
+    // source or be shut down first.
+    void cancelAfter(TimerWheel& timers, std::chrono::milliseconds timeout);
+
+private:
+    std::shared_ptr<CancellationToken::State> state_;
+};
+
+namespace detail {
+
+// Calls func(token) when it accepts a token, otherwise func().
+template <typename Func>
+decltype(auto) invokeCancellable(Func& func, const CancellationToken& token) {
+    if constexpr (std::is_invocable_v<Func&, const CancellationToken&>) {
+        return func(token);
+    } else {
+        return func();
+    }
+}
+
+template <typename Func>
+using CancellableResult = decltype(invokeCancellable(std::declval<Func&>(), std::declval<const CancellationToken&>()));
+
+} // namespace detail
+
+} // namespace LicenseChain
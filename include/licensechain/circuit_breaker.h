@@ -0,0 +1,144 @@
+#pragma once
+
+#include "exceptions.h"
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+
+namespace LicenseChain {
+
+enum class CircuitState {
+    Closed,    // requests flow; outcomes are counted
+    Open,      // requests fail fast or use the fallback
+    HalfOpen,  // a few probes test whether the endpoint recovered
+};
+
+struct CircuitBreakerOptions {
+    double failure_rate_threshold = 0.5;
+    uint32_t minimum_requests = 20;                // in the window, before the rate counts
+    std::chrono::milliseconds window{10000};
+    std::chrono::milliseconds open_duration{5000}; // before the first probe
+    uint32_t half_open_probes = 3;                 // successes needed to close again
+};
+
+struct CircuitBreakerMetrics {
+    CircuitState state;
+    uint64_t successes;         // in the current window
+    uint64_t failures;
+    uint64_t short_circuited;   // requests refused while open
+    uint64_t opened;            // times the circuit opened
+};
+
+// Per-endpoint circuit breaker. Failures are counted over a rolling window
+// of ten buckets; once at least minimum_requests were seen and the failure
+// rate reaches the threshold, the circuit opens and requests fail fast with
+// CircuitOpenException, or are answered by a fallback such as
+// ResponseCache::getStale(). After open_duration, up to half_open_probes
+// requests go through; that many successes close the circuit, and any
+// failure opens it again.
+//
+// Only errors that say the endpoint is unhealthy count as failures:
+// network errors, 5xx, timeouts and exceeded deadlines. Validation,
+// authentication, not-found and rate-limit responses prove the endpoint is
+// up and count as successes. A request its caller cancelled proves nothing
+// either way and is not counted.
+class CircuitBreaker {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit CircuitBreaker(CircuitBreakerOptions options = {});
+
+    // Whether a request may go out now. A true result in the half-open
+    // state reserves a probe, so it must be followed by a record call.
+    bool allowRequest();
+    void recordSuccess();
+    void recordFailure();
+    // Returns a reserved half-open probe without counting an outcome.
+    void abandon();
+    void record(const std::exception_ptr& error);
+
+    template <typename Func>
+    auto execute(Func func) -> decltype(func());
+    // As execute(), but returns fallback() instead of throwing while open.
+    template <typename Func, typename Fallback>
+    auto execute(Func func, Fallback fallback) -> decltype(func());
+
+    static bool isFailure(const std::exception_ptr& error);
+
+    CircuitState state() const;
+    CircuitBreakerMetrics metrics() const;
+
+private:
+    static constexpr size_t BUCKETS = 10;
+
+    struct Bucket {
+        int64_t epoch = -1;
+        uint32_t successes = 0;
+        uint32_t failures = 0;
+    };
+
+    Bucket& currentBucket(Clock::time_point now);
+    void totals(Clock::time_point now, uint64_t& successes, uint64_t& failures) const;
+    void open(Clock::time_point now);
+
+    const CircuitBreakerOptions options_;
+    const Clock::duration bucket_width_;
+
+    mutable std::mutex mutex_;
+    CircuitState state_ = CircuitState::Closed;
+    Clock::time_point opened_at_{};
+    uint32_t probes_started_ = 0;
+    uint32_t probes_succeeded_ = 0;
+    std::array<Bucket, BUCKETS> buckets_{};
+    uint64_t short_circuited_ = 0;
+    uint64_t opened_ = 0;
+};
+
+// Breakers keyed by endpoint, created on first use. References stay valid
+// for the registry's lifetime.
+class CircuitBreakerRegistry {
+public:
+    explicit CircuitBreakerRegistry(CircuitBreakerOptions options = {});
+
+    CircuitBreaker& forEndpoint(const std::string& endpoint);
+
+private:
+    const CircuitBreakerOptions options_;
+    mutable std::shared_mutex mutex_;
+    std::unordered_map<std::string, std::unique_ptr<CircuitBreaker>> breakers_;
+};
+
+template <typename Func>
+auto CircuitBreaker::execute(Func func) -> decltype(func()) {
+    using Result = decltype(func());
+    return execute(std::move(func), []() -> Result {
+        throw CircuitOpenException("Circuit open; request not sent");
+    });
+}
+
+template <typename Func, typename Fallback>
+auto CircuitBreaker::execute(Func func, Fallback fallback) -> decltype(func()) {
+    if (!allowRequest()) return fallback();
+    try {
+        if constexpr (std::is_void_v<decltype(func())>) {
+            func();
+            recordSuccess();
+        } else {
+            auto result = func();
+            recordSuccess();
+            return result;
+        }
+    } catch (...) {
+        record(std::current_exception());
+        throw;
+    }
+}
+
+} // namespace LicenseChain
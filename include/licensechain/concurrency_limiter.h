@@ -0,0 +1,110 @@
+#pragma once
+
+#include "endpoint_class.h"
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+
+namespace LicenseChain {
+
+struct ConcurrencyLimitOptions {
+    size_t initial_limit = 20;
+    size_t min_limit = 1;
+    size_t max_limit = 200;
+    double smoothing = 0.2;          // weight of each new limit estimate
+    double rtt_tolerance = 1.5;      // short-term RTT this far above baseline is not yet congestion
+    double backoff_ratio = 0.9;      // limit kept after a dropped request
+    double reserved_share = 0.2;     // of the limit, usable only by Validation (at least one slot)
+};
+
+struct ConcurrencyLimiterMetrics {
+    size_t limit;
+    size_t reserved;                          // slots only Validation may take
+    size_t in_flight;
+    size_t waiting[REQUEST_PRIORITY_COUNT];   // indexed by RequestPriority
+    std::chrono::nanoseconds short_rtt;
+    std::chrono::nanoseconds baseline_rtt;
+    uint64_t acquired;
+    uint64_t rejected;
+    uint64_t dropped;
+};
+
+// Bounds in-flight requests with a limit that follows measured RTT.
+//
+// Each completed request updates a moving average of RTT and a baseline,
+// the minimum RTT seen (allowed to drift up slowly). While the average
+// stays within rtt_tolerance of the baseline the limit grows by about its
+// square root; as queueing pushes RTT up, the gradient baseline/average
+// shrinks the limit toward what the upstream can serve.
+// Timeouts and server errors cut it multiplicatively. Growth is skipped
+// unless at least half the limit is in use, so an idle client does not
+// inflate it.
+//
+// A share of the limit is reserved for Validation, so other traffic can
+// never hold every slot, and a freed slot goes to the highest priority
+// that is waiting for one.
+class ConcurrencyLimiter {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    enum class Outcome {
+        Success,  // completed; RTT is sampled
+        Dropped,  // timed out or overloaded upstream; limit backs off
+        Ignored,  // failed for reasons unrelated to load; no sample
+    };
+
+    // A held slot. Releasing records the outcome; destroying an unreleased
+    // permit releases it as Ignored.
+    class Permit {
+    public:
+        Permit(Permit&& other) noexcept;
+        Permit& operator=(Permit&& other) noexcept;
+        Permit(const Permit&) = delete;
+        Permit& operator=(const Permit&) = delete;
+        ~Permit();
+
+        void release(Outcome outcome = Outcome::Success);
+
+    private:
+        friend class ConcurrencyLimiter;
+        Permit(ConcurrencyLimiter* limiter, Clock::time_point start) : limiter_(limiter), start_(start) {}
+
+        ConcurrencyLimiter* limiter_;
+        Clock::time_point start_;
+    };
+
+    explicit ConcurrencyLimiter(ConcurrencyLimitOptions options = {});
+
+    std::optional<Permit> tryAcquire(RequestPriority priority = RequestPriority::Interactive);
+    // Waits up to maxWait for a slot.
+    std::optional<Permit> acquire(std::chrono::milliseconds maxWait,
+                                  RequestPriority priority = RequestPriority::Interactive);
+
+    size_t limit() const;
+    ConcurrencyLimiterMetrics metrics() const;
+
+private:
+    void release(Clock::time_point start, Outcome outcome);
+    size_t reservedLocked() const;
+    bool availableLocked(RequestPriority priority) const;
+    Permit grantLocked();
+
+    const ConcurrencyLimitOptions options_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable available_;
+    double limit_;
+    size_t in_flight_ = 0;
+    std::array<size_t, REQUEST_PRIORITY_COUNT> waiting_{};
+    double short_rtt_ = 0;   // nanoseconds
+    double baseline_rtt_ = 0;
+    uint64_t acquired_ = 0;
+    uint64_t rejected_ = 0;
+    uint64_t dropped_ = 0;
+};
+
+} // namespace LicenseChain
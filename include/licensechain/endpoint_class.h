@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+
+namespace LicenseChain {
+
+// Coarse request classes used to partition client-side limits and capacity.
+enum class EndpointClass {
+    Validation,  // license validation on the login path
+    Read,        // other idempotent GETs
+    Write,       // creates, updates, deletes and actions
+    Analytics,   // analytics, stats, usage reports and bulk exports
+};
+
+constexpr size_t ENDPOINT_CLASS_COUNT = 4;
+
+// Scheduling priority, highest first. Validation has capacity reserved in
+// the executor queue and the concurrency limiter that nothing else can use.
+enum class RequestPriority {
+    Validation,
+    Interactive,
+    Background,
+};
+
+constexpr size_t REQUEST_PRIORITY_COUNT = 3;
+
+inline EndpointClass classifyEndpoint(std::string_view method, std::string_view path) {
+    if (path.find("/validate") != std::string_view::npos || path.find("/verify") != std::string_view::npos) {
+        return EndpointClass::Validation;
+    }
+    if (path.find("/analytics") != std::string_view::npos || path.find("/stats") != std::string_view::npos ||
+        path.find("/usage") != std::string_view::npos || path.find("/export") != std::string_view::npos) {
+        return EndpointClass::Analytics;
+    }
+    return method == "GET" || method == "HEAD" ? EndpointClass::Read : EndpointClass::Write;
+}
+
+inline RequestPriority priorityOf(EndpointClass cls) {
+    switch (cls) {
+        case EndpointClass::Validation:
+            return RequestPriority::Validation;
+        case EndpointClass::Analytics:
+            return RequestPriority::Background;
+        default:
+            return RequestPriority::Interactive;
+    }
+}
+
+} // namespace LicenseChain
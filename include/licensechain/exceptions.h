@@ -60,6 +60,24 @@ public:
         : LicenseChainException("SERVER_ERROR", message, 500) {}
 };
 
+class CircuitOpenException : public LicenseChainException {
+public:
+    explicit CircuitOpenException(const std::string& message)
+        : LicenseChainException("CIRCUIT_OPEN", message, 503) {}
+};
+
+class CancelledException : public LicenseChainException {
+public:
+    explicit CancelledException(const std::string& message)
+        : LicenseChainException("CANCELLED", message, 499) {}
+};
+
+class DeadlineExceededException : public LicenseChainException {
+public:
+    explicit DeadlineExceededException(const std::string& message)
+        : LicenseChainException("DEADLINE_EXCEEDED", message, 504) {}
+};
+
 class ConfigurationException : public LicenseChainException {
 public:
     explicit ConfigurationException(const std::string& message)
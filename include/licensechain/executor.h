@@ -0,0 +1,113 @@
+#pragma once
+
+#include "endpoint_class.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace LicenseChain {
+
+struct ExecutorMetrics {
+    size_t queue_length;
+    uint64_t submitted;
+    uint64_t completed;
+    uint64_t rejected;
+    uint64_t failed;
+    std::chrono::nanoseconds average_queue_latency;
+    std::chrono::nanoseconds max_queue_latency;
+    std::chrono::nanoseconds average_run_time;
+};
+
+// Fixed pool of worker threads, each with a FIFO queue per priority.
+//
+// Tasks posted with the same key always run on the same worker, so they run
+// one at a time and, within a priority, in submission order; tasks with
+// different keys run in parallel. Unkeyed tasks are spread round-robin. A
+// worker always takes its highest-priority task first. When maxQueueDepth is
+// non-zero, post() blocks and tryPost() fails while that many tasks are
+// waiting; the last reservedDepth of those places only take Validation
+// tasks, so a backlog of other work cannot lock validation out.
+//
+// Priority within a worker's queue does not help a Validation task whose
+// worker is busy with a long export. With reservedThreads, unkeyed
+// Validation tasks instead go to a shared queue served by that many extra
+// threads that run nothing else; regular workers also take from it between
+// their own tasks. Exceptions thrown by tasks are counted and otherwise
+// ignored.
+class Executor {
+public:
+    using Task = std::function<void()>;
+
+    explicit Executor(size_t threads = 0, size_t maxQueueDepth = 0, size_t reservedDepth = 0,
+                      size_t reservedThreads = 0);
+    ~Executor();
+
+    Executor(const Executor&) = delete;
+    Executor& operator=(const Executor&) = delete;
+
+    bool post(Task task, RequestPriority priority = RequestPriority::Interactive);
+    bool post(uint64_t key, Task task, RequestPriority priority = RequestPriority::Interactive);
+    bool tryPost(Task task, RequestPriority priority = RequestPriority::Interactive);
+    bool tryPost(uint64_t key, Task task, RequestPriority priority = RequestPriority::Interactive);
+
+    // Stops accepting tasks, runs everything already queued and joins the
+    // workers. Called by the destructor.
+    void shutdown();
+
+    size_t threadCount() const { return workers_.size() + validation_threads_.size(); }
+    size_t queueLength() const { return queued_.load(std::memory_order_relaxed); }
+    ExecutorMetrics metrics() const;
+
+private:
+    struct Item {
+        Task task;
+        std::chrono::steady_clock::time_point enqueued;
+    };
+
+    struct Worker {
+        std::mutex mutex;
+        std::condition_variable ready;
+        std::array<std::deque<Item>, REQUEST_PRIORITY_COUNT> queues;   // indexed by RequestPriority
+        std::thread thread;
+    };
+
+    Worker& workerFor(size_t index, RequestPriority priority);
+    bool submit(Worker& worker, Task task, RequestPriority priority, bool wait);
+    bool reserve(RequestPriority priority, bool wait);
+    void release();
+    void run(Worker& worker);
+    void runValidation();
+    bool takeValidation(Item& item);
+    void execute(Item& item);
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+    Worker validation_;                          // shared queue for unkeyed Validation tasks
+    std::vector<std::thread> validation_threads_;
+    size_t max_queue_depth_;
+    size_t reserved_depth_;
+    std::atomic<size_t> queued_{0};
+    std::atomic<size_t> next_worker_{0};
+    std::atomic<bool> stopping_{false};
+    std::mutex space_mutex_;
+    std::condition_variable space_available_;
+    std::atomic<size_t> space_waiters_{0};
+
+    std::atomic<uint64_t> submitted_{0};
+    std::atomic<uint64_t> completed_{0};
+    std::atomic<uint64_t> rejected_{0};
+    std::atomic<uint64_t> failed_{0};
+    std::atomic<int64_t> total_queue_ns_{0};
+    std::atomic<int64_t> max_queue_ns_{0};
+    std::atomic<int64_t> total_run_ns_{0};
+};
+
+} // namespace LicenseChain
@@ -0,0 +1,209 @@
+#pragma once
+
+#include "cancellation.h"
+#include "exceptions.h"
+#include "executor.h"
+#include "retry.h"
+#include "timer_wheel.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <future>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace LicenseChain {
+
+// Approximate latency distribution: a histogram with buckets growing by a
+// quarter, from 100 µs to about 2 minutes. Counts halve every
+// `decayInterval` samples so percentiles follow recent behaviour. Recording
+// is lock-free; a concurrent decay may lose a sample, which is harmless.
+class LatencyTracker {
+public:
+    explicit LatencyTracker(uint64_t decayInterval = 2000);
+
+    void record(std::chrono::nanoseconds latency);
+    // Upper bound of the bucket holding the given quantile (0..1); zero
+    // until at least `minimumSamples` are in the histogram.
+    std::chrono::nanoseconds percentile(double quantile, uint64_t minimumSamples = 20) const;
+    uint64_t count() const;
+
+private:
+    static constexpr size_t BUCKETS = 64;
+
+    static size_t bucketFor(std::chrono::nanoseconds latency);
+    static std::chrono::nanoseconds bucketLimit(size_t bucket);
+
+    const uint64_t decay_interval_;
+    std::array<std::atomic<uint64_t>, BUCKETS> counts_{};
+    std::atomic<uint64_t> since_decay_{0};
+};
+
+struct HedgingPolicy {
+    double percentile = 0.95;                    // hedge once a call is slower than this share of calls
+    std::chrono::milliseconds initial_delay{50}; // until enough latencies are recorded
+    std::chrono::milliseconds min_delay{5};
+    std::chrono::milliseconds max_delay{2000};
+};
+
+struct HedgingStats {
+    uint64_t calls;
+    uint64_t hedges;            // second attempts sent
+    uint64_t hedge_wins;        // calls answered by the second attempt
+    uint64_t budget_exhausted;  // hedges skipped for lack of budget
+};
+
+// Runs idempotent calls on an Executor and, if one has not answered within
+// the policy's percentile of recent latency, starts a second attempt. The
+// first success completes the future and cancels the other attempt's token,
+// so its transport can drop the connection. A call fails only when every
+// attempt it started has failed, or when the caller's token is cancelled.
+//
+// The function is invoked as func(const CancellationToken&), or func(), and
+// must be safe to run twice concurrently. Hedges draw on a RetryBudget
+// (by default 5% of calls), so hedging adds a bounded share of load.
+class RequestHedger {
+public:
+    RequestHedger(Executor& executor, TimerWheel& timers, HedgingPolicy policy = {},
+                  std::shared_ptr<RetryBudget> budget = std::make_shared<RetryBudget>(0.05, 5.0));
+
+    template <typename Func>
+    auto submit(Func func, const CancellationToken& token = {}, RequestPriority priority = RequestPriority::Interactive)
+        -> std::future<detail::CancellableResult<Func>>;
+
+    // Delay after which a call is hedged, from the current latency estimate.
+    std::chrono::milliseconds hedgeDelay() const;
+
+    const LatencyTracker& latencies() const { return latencies_; }
+    HedgingStats stats() const;
+
+private:
+    template <typename Func>
+    struct Call {
+        using Result = detail::CancellableResult<Func>;
+        Call(Func f, const CancellationToken& parent, RequestPriority p) : func(std::move(f)), source(parent), priority(p) {}
+        Func func;
+        CancellationSource source;          // cancelled once the call is settled
+        const RequestPriority priority;
+        std::promise<Result> promise;
+        std::atomic<bool> done{false};
+        std::atomic<int> outstanding{0};
+        std::atomic<uint64_t> timer{0};
+    };
+
+    template <typename Func>
+    void attempt(std::shared_ptr<Call<Func>> call, bool hedge);
+    template <typename Func>
+    void hedge(std::shared_ptr<Call<Func>> call);
+    template <typename Func>
+    void fail(const std::shared_ptr<Call<Func>>& call, std::exception_ptr error);
+
+    Executor& executor_;
+    TimerWheel& timers_;
+    HedgingPolicy policy_;
+    std::shared_ptr<RetryBudget> budget_;
+    LatencyTracker latencies_;
+
+    std::atomic<uint64_t> calls_{0};
+    std::atomic<uint64_t> hedges_{0};
+    std::atomic<uint64_t> hedge_wins_{0};
+    std::atomic<uint64_t> budget_exhausted_{0};
+};
+
+template <typename Func>
+auto RequestHedger::submit(Func func, const CancellationToken& token, RequestPriority priority)
+    -> std::future<detail::CancellableResult<Func>> {
+    auto call = std::make_shared<Call<Func>>(std::move(func), token, priority);
+    auto future = call->promise.get_future();
+    calls_.fetch_add(1, std::memory_order_relaxed);
+    budget_->recordRequest();
+
+    // Settles the call if the caller gives up; after a normal finish the
+    // source is cancelled too, and then this finds the call already done.
+    std::weak_ptr<Call<Func>> weak = call;
+    call->source.token().onCancel([this, weak] {
+        auto c = weak.lock();
+        if (c && !c->done.exchange(true)) {
+            c->promise.set_exception(c->source.token().error());
+            timers_.cancel(c->timer.load());
+        }
+    });
+    if (call->done.load()) return future;
+
+    call->outstanding.store(1);
+    if (!executor_.post([this, call] { attempt(call, false); }, call->priority)) {
+        if (!call->done.exchange(true)) {
+            call->promise.set_exception(std::make_exception_ptr(LicenseChainException("EXECUTOR_SHUTDOWN", "Executor is shut down")));
+        }
+        return future;
+    }
+    call->timer.store(timers_.schedule(hedgeDelay(), [this, call] { hedge(call); }));
+    // The call may have finished before the timer id was stored.
+    if (call->done.load()) timers_.cancel(call->timer.load());
+    return future;
+}
+
+template <typename Func>
+void RequestHedger::hedge(std::shared_ptr<Call<Func>> call) {
+    if (call->done.load()) return;
+    if (!budget_->tryWithdraw()) {
+        budget_exhausted_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    call->outstanding.fetch_add(1);
+    // The primary may have settled the call in between; nothing waits on
+    // the count after that.
+    if (call->done.load()) {
+        call->outstanding.fetch_sub(1);
+        return;
+    }
+    hedges_.fetch_add(1, std::memory_order_relaxed);
+    if (!executor_.tryPost([this, call] { attempt(call, true); }, call->priority)) {
+        fail(call, std::make_exception_ptr(LicenseChainException("EXECUTOR_SHUTDOWN", "Executor rejected hedged attempt")));
+    }
+}
+
+template <typename Func>
+void RequestHedger::fail(const std::shared_ptr<Call<Func>>& call, std::exception_ptr error) {
+    // The last attempt to fail settles the call.
+    if (call->outstanding.fetch_sub(1) == 1 && !call->done.exchange(true)) {
+        call->promise.set_exception(error);
+        timers_.cancel(call->timer.load());
+        call->source.cancel();
+    }
+}
+
+template <typename Func>
+void RequestHedger::attempt(std::shared_ptr<Call<Func>> call, bool hedge) {
+    using Result = typename Call<Func>::Result;
+    if (call->done.load()) {
+        call->outstanding.fetch_sub(1);
+        return;
+    }
+    const auto start = std::chrono::steady_clock::now();
+    const CancellationToken token = call->source.token();
+    try {
+        if constexpr (std::is_void_v<Result>) {
+            detail::invokeCancellable(call->func, token);
+            latencies_.record(std::chrono::steady_clock::now() - start);
+            if (!call->done.exchange(true)) call->promise.set_value();
+            else return;
+        } else {
+            Result result = detail::invokeCancellable(call->func, token);
+            latencies_.record(std::chrono::steady_clock::now() - start);
+            if (!call->done.exchange(true)) call->promise.set_value(std::move(result));
+            else return;
+        }
+        if (hedge) hedge_wins_.fetch_add(1, std::memory_order_relaxed);
+        timers_.cancel(call->timer.load());
+        // Stops the other attempt if it is still running.
+        call->source.cancel();
+    } catch (...) {
+        fail(call, std::current_exception());
+    }
+}
+
+} // namespace LicenseChain
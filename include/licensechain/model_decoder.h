@@ -0,0 +1,41 @@
+#pragma once
+
+#include "models.h"
+#include "pmr_models.h"
+#include <string>
+#include <string_view>
+#include <memory_resource>
+
+namespace LicenseChain {
+
+// Decodes API response bodies into the model structs. The JSON is consumed
+// through a streaming SAX pass, so no intermediate DOM is built.
+//
+// The pmr overloads draw every string, map node and vector buffer from the
+// supplied memory_resource; pair them with a std::pmr::monotonic_buffer_resource
+// per response or per request to release the decoded result in one shot.
+// The resource must outlive the returned object.
+//
+// All functions throw LicenseChainException ("DECODE_ERROR") on malformed JSON.
+class ModelDecoder {
+public:
+    static License decodeLicense(std::string_view json);
+    static LicenseListResponse decodeLicenseList(std::string_view json);
+    static User decodeUser(std::string_view json);
+    static UserListResponse decodeUserList(std::string_view json);
+    static Product decodeProduct(std::string_view json);
+    static ProductListResponse decodeProductList(std::string_view json);
+    static Webhook decodeWebhook(std::string_view json);
+    static WebhookListResponse decodeWebhookList(std::string_view json);
+
+    static pmr::License decodeLicense(std::string_view json, std::pmr::memory_resource* resource);
+    static pmr::LicenseListResponse decodeLicenseList(std::string_view json, std::pmr::memory_resource* resource);
+    static pmr::User decodeUser(std::string_view json, std::pmr::memory_resource* resource);
+    static pmr::UserListResponse decodeUserList(std::string_view json, std::pmr::memory_resource* resource);
+    static pmr::Product decodeProduct(std::string_view json, std::pmr::memory_resource* resource);
+    static pmr::ProductListResponse decodeProductList(std::string_view json, std::pmr::memory_resource* resource);
+    static pmr::Webhook decodeWebhook(std::string_view json, std::pmr::memory_resource* resource);
+    static pmr::WebhookListResponse decodeWebhookList(std::string_view json, std::pmr::memory_resource* resource);
+};
+
+} // namespace LicenseChain
@@ -5,6 +5,7 @@
 #include <map>
 #include <chrono>
 #include <optional>
+#include <string_view>
 
 namespace LicenseChain {
 
@@ -157,6 +158,22 @@ struct WebhookEvent {
     std::string signature;
 };
 
+// Non-owning view of a webhook event, pointing into the caller's payload
+// buffer. `id` and `type` are the raw JSON string contents (escape sequences
+// are not decoded) and `data` is the raw JSON text of the "data" member. The
+// view is only valid while the payload and signature buffers are alive.
+struct WebhookEventView {
+    std::string_view id;
+    std::string_view type;
+    std::string_view data;
+    std::chrono::system_clock::time_point timestamp;
+    std::string_view signature;
+    
+    WebhookEvent toEvent() const {
+        return WebhookEvent{std::string(id), std::string(type), std::string(data), timestamp, std::string(signature)};
+    }
+};
+
 struct HealthResponse {
     std::string status;
     std::string timestamp;
@@ -0,0 +1,172 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <map>
+#include <chrono>
+#include <optional>
+#include <cstddef>
+#include <memory_resource>
+
+namespace LicenseChain {
+namespace pmr {
+
+// Allocator-aware variants of the response models in models.h. Every string,
+// map node and vector buffer is drawn from the memory_resource passed at
+// construction, so a whole decoded response can live in a single
+// std::pmr::monotonic_buffer_resource and be released in one shot.
+
+using allocator_type = std::pmr::polymorphic_allocator<std::byte>;
+using StringMap = std::pmr::map<std::pmr::string, std::pmr::string>;
+
+struct License {
+    using allocator_type = pmr::allocator_type;
+
+    explicit License(const allocator_type& alloc = {})
+        : id(alloc), user_id(alloc), product_id(alloc), license_key(alloc), status(alloc), metadata(alloc) {}
+    License(const License& other, const allocator_type& alloc)
+        : id(other.id, alloc), user_id(other.user_id, alloc), product_id(other.product_id, alloc),
+          license_key(other.license_key, alloc), status(other.status, alloc),
+          created_at(other.created_at), updated_at(other.updated_at), expires_at(other.expires_at),
+          metadata(other.metadata, alloc) {}
+    License(License&& other, const allocator_type& alloc)
+        : id(std::move(other.id), alloc), user_id(std::move(other.user_id), alloc),
+          product_id(std::move(other.product_id), alloc), license_key(std::move(other.license_key), alloc),
+          status(std::move(other.status), alloc), created_at(other.created_at), updated_at(other.updated_at),
+          expires_at(other.expires_at), metadata(std::move(other.metadata), alloc) {}
+    License(const License&) = default;
+    License(License&&) = default;
+    License& operator=(const License&) = default;
+    License& operator=(License&&) = default;
+
+    allocator_type get_allocator() const { return id.get_allocator(); }
+
+    std::pmr::string id;
+    std::pmr::string user_id;
+    std::pmr::string product_id;
+    std::pmr::string license_key;
+    std::pmr::string status;
+    std::chrono::system_clock::time_point created_at;
+    std::chrono::system_clock::time_point updated_at;
+    std::optional<std::chrono::system_clock::time_point> expires_at;
+    StringMap metadata;
+};
+
+struct User {
+    using allocator_type = pmr::allocator_type;
+
+    explicit User(const allocator_type& alloc = {})
+        : id(alloc), email(alloc), name(alloc), metadata(alloc) {}
+    User(const User& other, const allocator_type& alloc)
+        : id(other.id, alloc), email(other.email, alloc), name(other.name, alloc),
+          created_at(other.created_at), updated_at(other.updated_at), metadata(other.metadata, alloc) {}
+    User(User&& other, const allocator_type& alloc)
+        : id(std::move(other.id), alloc), email(std::move(other.email), alloc), name(std::move(other.name), alloc),
+          created_at(other.created_at), updated_at(other.updated_at), metadata(std::move(other.metadata), alloc) {}
+    User(const User&) = default;
+    User(User&&) = default;
+    User& operator=(const User&) = default;
+    User& operator=(User&&) = default;
+
+    allocator_type get_allocator() const { return id.get_allocator(); }
+
+    std::pmr::string id;
+    std::pmr::string email;
+    std::pmr::string name;
+    std::chrono::system_clock::time_point created_at;
+    std::chrono::system_clock::time_point updated_at;
+    StringMap metadata;
+};
+
+struct Product {
+    using allocator_type = pmr::allocator_type;
+
+    explicit Product(const allocator_type& alloc = {})
+        : id(alloc), name(alloc), currency(alloc), metadata(alloc) {}
+    Product(const Product& other, const allocator_type& alloc)
+        : id(other.id, alloc), name(other.name, alloc), price(other.price), currency(other.currency, alloc),
+          created_at(other.created_at), updated_at(other.updated_at), metadata(other.metadata, alloc) {
+        if (other.description) description.emplace(*other.description, alloc);
+    }
+    Product(Product&& other, const allocator_type& alloc)
+        : id(std::move(other.id), alloc), name(std::move(other.name), alloc), price(other.price),
+          currency(std::move(other.currency), alloc), created_at(other.created_at),
+          updated_at(other.updated_at), metadata(std::move(other.metadata), alloc) {
+        if (other.description) description.emplace(std::move(*other.description), alloc);
+    }
+    Product(const Product&) = default;
+    Product(Product&&) = default;
+    Product& operator=(const Product&) = default;
+    Product& operator=(Product&&) = default;
+
+    allocator_type get_allocator() const { return id.get_allocator(); }
+
+    std::pmr::string id;
+    std::pmr::string name;
+    std::optional<std::pmr::string> description;
+    double price = 0.0;
+    std::pmr::string currency;
+    std::chrono::system_clock::time_point created_at;
+    std::chrono::system_clock::time_point updated_at;
+    StringMap metadata;
+};
+
+struct Webhook {
+    using allocator_type = pmr::allocator_type;
+
+    explicit Webhook(const allocator_type& alloc = {})
+        : id(alloc), url(alloc), events(alloc) {}
+    Webhook(const Webhook& other, const allocator_type& alloc)
+        : id(other.id, alloc), url(other.url, alloc), events(other.events, alloc),
+          created_at(other.created_at), updated_at(other.updated_at) {
+        if (other.secret) secret.emplace(*other.secret, alloc);
+    }
+    Webhook(Webhook&& other, const allocator_type& alloc)
+        : id(std::move(other.id), alloc), url(std::move(other.url), alloc), events(std::move(other.events), alloc),
+          created_at(other.created_at), updated_at(other.updated_at) {
+        if (other.secret) secret.emplace(std::move(*other.secret), alloc);
+    }
+    Webhook(const Webhook&) = default;
+    Webhook(Webhook&&) = default;
+    Webhook& operator=(const Webhook&) = default;
+    Webhook& operator=(Webhook&&) = default;
+
+    allocator_type get_allocator() const { return id.get_allocator(); }
+
+    std::pmr::string id;
+    std::pmr::string url;
+    std::pmr::vector<std::pmr::string> events;
+    std::optional<std::pmr::string> secret;
+    std::chrono::system_clock::time_point created_at;
+    std::chrono::system_clock::time_point updated_at;
+};
+
+template<typename T>
+struct ListResponse {
+    using allocator_type = pmr::allocator_type;
+
+    explicit ListResponse(const allocator_type& alloc = {}) : data(alloc) {}
+    ListResponse(const ListResponse& other, const allocator_type& alloc)
+        : data(other.data, alloc), total(other.total), page(other.page), limit(other.limit) {}
+    ListResponse(ListResponse&& other, const allocator_type& alloc)
+        : data(std::move(other.data), alloc), total(other.total), page(other.page), limit(other.limit) {}
+    ListResponse(const ListResponse&) = default;
+    ListResponse(ListResponse&&) = default;
+    ListResponse& operator=(const ListResponse&) = default;
+    ListResponse& operator=(ListResponse&&) = default;
+
+    allocator_type get_allocator() const { return data.get_allocator(); }
+
+    std::pmr::vector<T> data;
+    int total = 0;
+    int page = 0;
+    int limit = 0;
+};
+
+using LicenseListResponse = ListResponse<License>;
+using UserListResponse = ListResponse<User>;
+using ProductListResponse = ListResponse<Product>;
+using WebhookListResponse = ListResponse<Webhook>;
+
+} // namespace pmr
+} // namespace LicenseChain
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "endpoint_class.h"
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+
+namespace LicenseChain {
+
+struct RateLimit {
+    double requests_per_second;
+    double burst;
+};
+
+struct RateLimiterStats {
+    double rate;                 // current pacing rate, requests per second
+    double tokens;
+    uint64_t granted;
+    uint64_t delayed;            // granted after waiting
+    uint64_t rejected;           // refused locally instead of sent
+    uint64_t rate_limited;       // 429 responses seen
+    bool server_paced;           // rate taken from rate-limit headers
+};
+
+// Token bucket per endpoint class that follows the server's quota.
+//
+// When responses carry X-RateLimit-Remaining and X-RateLimit-Reset, the
+// bucket paces the remaining requests evenly over the time left in the
+// window, so throughput converges on the quota instead of probing past it.
+// A 429 with Retry-After blocks the class until then. Without headers a 429
+// cuts the rate by a fifth, and clean responses restore it by 1% of the
+// configured rate per second, never above the configured limit.
+class AdaptiveRateLimiter {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    AdaptiveRateLimiter();
+
+    void setLimit(EndpointClass cls, RateLimit limit);
+    RateLimit getLimit(EndpointClass cls) const;
+
+    // Takes a token now, or returns false (fail fast).
+    bool tryAcquire(EndpointClass cls);
+    // Takes a token, waiting up to maxWait for it; false if that is not enough.
+    bool acquire(EndpointClass cls, std::chrono::milliseconds maxWait);
+    // Takes a token that becomes usable after the returned delay, for callers
+    // that schedule the send instead of blocking; nullopt if over maxWait.
+    std::optional<Clock::duration> reserve(EndpointClass cls, std::chrono::milliseconds maxWait);
+    // As acquire(), but throws RateLimitException instead of sending a
+    // request the server would refuse.
+    void acquireOrThrow(EndpointClass cls, std::chrono::milliseconds maxWait = std::chrono::milliseconds(0));
+
+    // Feedback from a completed request. Header names are matched without
+    // regard to case; Retry-After is read in seconds.
+    void onResponse(EndpointClass cls, int statusCode, const std::map<std::string, std::string>& headers);
+    void onRateLimited(EndpointClass cls, std::chrono::milliseconds retryAfter);
+
+    RateLimiterStats stats(EndpointClass cls) const;
+
+private:
+    struct Bucket {
+        mutable std::mutex mutex;
+        RateLimit configured{10.0, 10.0};
+        double rate = 10.0;
+        double tokens = 10.0;
+        Clock::time_point updated = Clock::now();
+        Clock::time_point blocked_until{};
+        Clock::time_point paced_until{};     // end of the server's current window
+        uint64_t granted = 0;
+        uint64_t delayed = 0;
+        uint64_t rejected = 0;
+        uint64_t rate_limited = 0;
+    };
+
+    void refill(Bucket& bucket, Clock::time_point now) const;
+
+    std::array<Bucket, ENDPOINT_CLASS_COUNT> buckets_;
+};
+
+} // namespace LicenseChain
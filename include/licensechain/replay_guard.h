@@ -0,0 +1,65 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+namespace LicenseChain {
+
+// Remembers event IDs for a fixed window to reject replayed deliveries.
+//
+// IDs are stored as 64-bit fingerprints in a ring of open-addressed tables,
+// one per slice of the window. Advancing time clears the slices that fell out
+// of the window, so memory is fixed at construction and lookups probe one
+// table per slice regardless of traffic. Each slice holds up to
+// expectedEventsPerSecond * (window / buckets) IDs; past that, new IDs are
+// accepted without being remembered and counted in overflows().
+class ReplayGuard {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit ReplayGuard(std::chrono::seconds window, size_t expectedEventsPerSecond = 1000, size_t buckets = 16);
+
+    // Records the ID; returns false if it was already seen within the window.
+    bool insert(std::string_view id);
+    bool insert(std::string_view id, Clock::time_point now);
+
+    bool contains(std::string_view id) const;
+    // Forgets an ID, e.g. when the event it belongs to could not be queued
+    // and the sender must be allowed to deliver it again.
+    void erase(std::string_view id);
+    void clear();
+
+    std::chrono::seconds window() const { return window_; }
+    size_t size() const;
+    size_t capacity() const { return max_per_bucket_ * ring_.size(); }
+    size_t memoryUsage() const { return ring_.size() * (slot_mask_ + 1) * sizeof(uint64_t); }
+    uint64_t overflows() const;
+
+private:
+    struct Bucket {
+        std::vector<uint64_t> slots;
+        size_t used = 0;   // live entries plus tombstones
+        size_t live = 0;
+    };
+
+    static uint64_t fingerprint(std::string_view id);
+    void advance(Clock::time_point now);
+    size_t findSlot(const Bucket& bucket, uint64_t fp) const;
+    bool containsLocked(uint64_t fp) const;
+
+    std::chrono::seconds window_;
+    Clock::duration bucket_span_;
+    Clock::time_point origin_;
+    int64_t current_epoch_ = 0;
+    std::vector<Bucket> ring_;
+    size_t slot_mask_;
+    size_t max_per_bucket_;
+    uint64_t overflows_ = 0;
+    mutable std::mutex mutex_;
+};
+
+} // namespace LicenseChain
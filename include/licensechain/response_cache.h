@@ -0,0 +1,92 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace LicenseChain {
+
+// Bounded LRU cache of API responses. Entries are fresh for `ttl` and may
+// still be served as a fallback, through getStale(), for up to `maxStale`
+// after they were stored, e.g. while a circuit breaker is open.
+template <typename Value>
+class ResponseCache {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit ResponseCache(size_t capacity = 10000,
+                           std::chrono::milliseconds ttl = std::chrono::minutes(1),
+                           std::chrono::milliseconds maxStale = std::chrono::hours(1))
+        : capacity_(capacity == 0 ? 1 : capacity), ttl_(ttl), max_stale_(std::max(ttl, maxStale)) {}
+
+    void put(const std::string& key, Value value) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = entries_.find(key);
+        if (it != entries_.end()) {
+            it->second.value = std::move(value);
+            it->second.stored = Clock::now();
+            order_.splice(order_.begin(), order_, it->second.position);
+            return;
+        }
+        if (entries_.size() >= capacity_) {
+            entries_.erase(order_.back());
+            order_.pop_back();
+        }
+        order_.push_front(key);
+        entries_.emplace(key, Entry{std::move(value), Clock::now(), order_.begin()});
+    }
+
+    std::optional<Value> get(const std::string& key) const { return lookup(key, ttl_); }
+    std::optional<Value> getStale(const std::string& key) const { return lookup(key, max_stale_); }
+
+    bool erase(const std::string& key) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = entries_.find(key);
+        if (it == entries_.end()) return false;
+        order_.erase(it->second.position);
+        entries_.erase(it);
+        return true;
+    }
+
+    void clear() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        entries_.clear();
+        order_.clear();
+    }
+
+    size_t size() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return entries_.size();
+    }
+
+private:
+    struct Entry {
+        Value value;
+        Clock::time_point stored;
+        std::list<std::string>::iterator position;
+    };
+
+    std::optional<Value> lookup(const std::string& key, std::chrono::milliseconds maxAge) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = entries_.find(key);
+        if (it == entries_.end() || Clock::now() - it->second.stored > maxAge) return std::nullopt;
+        order_.splice(order_.begin(), order_, it->second.position);
+        return it->second.value;
+    }
+
+    const size_t capacity_;
+    const std::chrono::milliseconds ttl_;
+    const std::chrono::milliseconds max_stale_;
+
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, Entry> entries_;
+    mutable std::list<std::string> order_;   // most recently used first
+};
+
+} // namespace LicenseChain
@@ -0,0 +1,197 @@
+#pragma once
+
+#include "cancellation.h"
+#include "exceptions.h"
+#include "executor.h"
+#include "timer_wheel.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <future>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace LicenseChain {
+
+struct RetryPolicy {
+    int max_attempts = 3;
+    std::chrono::milliseconds base_delay{100};
+    std::chrono::milliseconds max_delay{10000};
+
+    // Decorrelated jitter: a random delay between base_delay and three times
+    // the previous one, capped at max_delay. Pass zero for the first retry.
+    std::chrono::milliseconds nextDelay(std::chrono::milliseconds previous) const;
+
+    // Network, rate-limit and 5xx server errors are retried; validation,
+    // authentication, not-found, configuration, open-circuit, cancellation,
+    // deadline and non-SDK exceptions are not.
+    static bool isRetryable(const std::exception_ptr& error);
+};
+
+// Caps retries at a fraction of traffic. Every first attempt deposits
+// `ratio` of a retry and every retry withdraws one, so under a total outage
+// retries add at most ratio * requests (plus the initial `reserve`) to load.
+class RetryBudget {
+public:
+    explicit RetryBudget(double ratio = 0.1, double reserve = 10.0);
+
+    void recordRequest();
+    bool tryWithdraw();
+    double balance() const;
+
+private:
+    static constexpr int64_t SCALE = 1000;
+
+    int64_t deposit_;
+    int64_t capacity_;
+    std::atomic<int64_t> balance_;
+};
+
+struct RetryStats {
+    uint64_t calls;
+    uint64_t retries;
+    uint64_t not_retryable;
+    uint64_t budget_exhausted;
+    uint64_t attempts_exhausted;
+};
+
+// Runs calls on an Executor and retries failures without holding a thread:
+// a failed attempt schedules the next one on a TimerWheel and returns.
+//
+// With a CancellationToken, the call is settled with its cancellation error
+// as soon as the token is cancelled, a pending retry timer is dropped, and
+// no retry is scheduled that could not start before the deadline. The
+// function may take the token (func(const CancellationToken&)) to pass it
+// on to the transport. Every attempt is queued at the call's priority.
+class RetryScheduler {
+public:
+    RetryScheduler(Executor& executor, TimerWheel& timers, RetryPolicy policy = {},
+                   std::shared_ptr<RetryBudget> budget = std::make_shared<RetryBudget>());
+
+    template <typename Func>
+    auto submit(Func func, CancellationToken token = {}, RequestPriority priority = RequestPriority::Interactive)
+        -> std::future<detail::CancellableResult<Func>>;
+
+    const RetryPolicy& policy() const { return policy_; }
+    const std::shared_ptr<RetryBudget>& budget() const { return budget_; }
+    RetryStats stats() const;
+
+private:
+    template <typename Func>
+    struct Call {
+        using Result = detail::CancellableResult<Func>;
+        Call(Func f, CancellationToken t, RequestPriority p) : func(std::move(f)), token(std::move(t)), priority(p) {}
+        Func func;
+        CancellationToken token;
+        const RequestPriority priority;
+        std::promise<Result> promise;
+        std::atomic<bool> settled{false};
+        std::exception_ptr error;
+        int attempt = 0;
+        std::chrono::milliseconds delay{0};
+        std::atomic<uint64_t> timer{0};
+        uint64_t cancel_callback = 0;
+
+        // True for the one caller that gets to complete the promise.
+        bool settle() {
+            if (settled.exchange(true)) return false;
+            token.removeCallback(cancel_callback);
+            return true;
+        }
+    };
+
+    template <typename Func>
+    void attempt(std::shared_ptr<Call<Func>> call);
+    template <typename Func>
+    void fail(const std::shared_ptr<Call<Func>>& call, std::exception_ptr error);
+
+    // Whether to retry after `error` on the given attempt (1-based); counts the outcome.
+    bool shouldRetry(const std::exception_ptr& error, int attempt);
+
+    Executor& executor_;
+    TimerWheel& timers_;
+    RetryPolicy policy_;
+    std::shared_ptr<RetryBudget> budget_;
+
+    std::atomic<uint64_t> calls_{0};
+    std::atomic<uint64_t> retries_{0};
+    std::atomic<uint64_t> not_retryable_{0};
+    std::atomic<uint64_t> budget_exhausted_{0};
+    std::atomic<uint64_t> attempts_exhausted_{0};
+};
+
+template <typename Func>
+auto RetryScheduler::submit(Func func, CancellationToken token, RequestPriority priority)
+    -> std::future<detail::CancellableResult<Func>> {
+    auto call = std::make_shared<Call<Func>>(std::move(func), std::move(token), priority);
+    auto future = call->promise.get_future();
+    calls_.fetch_add(1, std::memory_order_relaxed);
+    budget_->recordRequest();
+
+    // The callback must not keep the call alive once it has finished.
+    std::weak_ptr<Call<Func>> weak = call;
+    call->cancel_callback = call->token.onCancel([this, weak] {
+        if (auto c = weak.lock()) {
+            timers_.cancel(c->timer.load());
+            fail(c, c->token.error());
+        }
+    });
+    if (call->settled.load()) return future;
+    if (!executor_.post([this, call] { attempt(call); }, call->priority)) {
+        fail(call, std::make_exception_ptr(LicenseChainException("EXECUTOR_SHUTDOWN", "Executor is shut down")));
+    }
+    return future;
+}
+
+template <typename Func>
+void RetryScheduler::fail(const std::shared_ptr<Call<Func>>& call, std::exception_ptr error) {
+    if (call->settle()) call->promise.set_exception(error);
+}
+
+template <typename Func>
+void RetryScheduler::attempt(std::shared_ptr<Call<Func>> call) {
+    using Result = typename Call<Func>::Result;
+    if (call->settled.load()) return;
+    if (call->token.isCancelled()) {
+        fail(call, call->token.error());
+        return;
+    }
+    ++call->attempt;
+    try {
+        if constexpr (std::is_void_v<Result>) {
+            detail::invokeCancellable(call->func, call->token);
+            if (call->settle()) call->promise.set_value();
+        } else {
+            Result result = detail::invokeCancellable(call->func, call->token);
+            if (call->settle()) call->promise.set_value(std::move(result));
+        }
+        return;
+    } catch (...) {
+        call->error = std::current_exception();
+    }
+
+    if (call->settled.load()) return;
+    // A retry that cannot start before the deadline would only waste a
+    // request; check before shouldRetry() spends budget on it.
+    const auto delay = policy_.nextDelay(call->delay);
+    if (call->token.isCancelled() || delay >= call->token.remaining() || !shouldRetry(call->error, call->attempt)) {
+        fail(call, call->error);
+        return;
+    }
+    call->delay = delay;
+    // Between attempts only the timer holds the call; no thread waits.
+    const uint64_t timer = timers_.schedule(call->delay, [this, call] {
+        if (!executor_.tryPost([this, call] { attempt(call); }, call->priority)) fail(call, call->error);
+    });
+    if (timer == 0) {
+        fail(call, call->error);
+        return;
+    }
+    call->timer.store(timer);
+    // Cancelled while scheduling: the callback may have missed the timer id.
+    if (call->settled.load()) timers_.cancel(timer);
+}
+
+} // namespace LicenseChain
@@ -2,6 +2,7 @@
 
 #include "models.h"
 #include "exceptions.h"
+#include <memory>
 #include <string>
 #include <vector>
 #include <map>
@@ -9,9 +10,11 @@
 
 namespace LicenseChain {
 
+class Session;
+
 class LicenseService {
 public:
-    LicenseService(const std::string& apiKey, const std::string& baseUrl);
+    explicit LicenseService(std::shared_ptr<Session> session);
     
     // License operations
     std::future<License> createLicenseAsync(const CreateLicenseRequest& request);
@@ -32,16 +35,14 @@ public:
     LicenseStats getLicenseStats();
 
 private:
-    std::string api_key_;
-    std::string base_url_;
+    std::shared_ptr<Session> session_;
     
     std::string makeRequest(const std::string& method, const std::string& endpoint, const std::string& body = "");
-    std::map<std::string, std::string> getHeaders();
 };
 
 class UserService {
 public:
-    UserService(const std::string& apiKey, const std::string& baseUrl);
+    explicit UserService(std::shared_ptr<Session> session);
     
     // User operations
     std::future<User> createUserAsync(const CreateUserRequest& request);
@@ -60,16 +61,14 @@ public:
     UserStats getUserStats();
 
 private:
-    std::string api_key_;
-    std::string base_url_;
+    std::shared_ptr<Session> session_;
     
     std::string makeRequest(const std::string& method, const std::string& endpoint, const std::string& body = "");
-    std::map<std::string, std::string> getHeaders();
 };
 
 class ProductService {
 public:
-    ProductService(const std::string& apiKey, const std::string& baseUrl);
+    explicit ProductService(std::shared_ptr<Session> session);
     
     // Product operations
     std::future<Product> createProductAsync(const CreateProductRequest& request);
@@ -88,16 +87,14 @@ public:
     ProductStats getProductStats();
 
 private:
-    std::string api_key_;
-    std::string base_url_;
+    std::shared_ptr<Session> session_;
     
     std::string makeRequest(const std::string& method, const std::string& endpoint, const std::string& body = "");
-    std::map<std::string, std::string> getHeaders();
 };
 
 class WebhookService {
 public:
-    WebhookService(const std::string& apiKey, const std::string& baseUrl);
+    explicit WebhookService(std::shared_ptr<Session> session);
     
     // Webhook operations
     std::future<Webhook> createWebhookAsync(const CreateWebhookRequest& request);
@@ -114,11 +111,9 @@ public:
     WebhookListResponse listWebhooks(int page = 1, int limit = 10);
 
 private:
-    std::string api_key_;
-    std::string base_url_;
+    std::shared_ptr<Session> session_;
     
     std::string makeRequest(const std::string& method, const std::string& endpoint, const std::string& body = "");
-    std::map<std::string, std::string> getHeaders();
 };
 
 } // namespace LicenseChain
@@ -0,0 +1,176 @@
+#pragma once
+
+#include "cancellation.h"
+#include "circuit_breaker.h"
+#include "concurrency_limiter.h"
+#include "endpoint_class.h"
+#include "executor.h"
+#include "rate_limiter.h"
+#include "response_cache.h"
+#include "retry.h"
+#include "timer_wheel.h"
+#include "token_manager.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace LicenseChain {
+
+// Headers sent with every request, built once per session.
+struct HeaderBlock {
+    std::vector<std::pair<std::string, std::string>> fields;
+    std::string serialized;   // "Name: value\r\n" per field, ready to copy onto the wire
+};
+
+struct HttpRequest {
+    std::string method;
+    std::string url;
+    std::shared_ptr<const HeaderBlock> headers;
+    // "Bearer ...", replaced on token refresh. Null when the request carries
+    // no credentials (no API key or token, e.g. TenantClient::jwks()):
+    // transports must check it and send no Authorization header then.
+    std::shared_ptr<const std::string> authorization;
+    uint64_t auth_generation = 0;   // AuthHeader::generation, or 0 if not from a TokenManager
+    std::string body;
+    std::chrono::milliseconds timeout;
+    CancellationToken token;
+    EndpointClass endpoint_class;
+    RequestPriority priority;   // lets a pooling transport hand out connections in this order
+};
+
+struct HttpResponse {
+    int status = 0;
+    std::map<std::string, std::string> headers;
+    std::string body;
+};
+
+// Credentials and rate-limit state of one API key. A Session has one for
+// its own key; TenantClient adds more that share the session's resources.
+struct Tenant {
+    std::string id;                                    // cache partition; empty for the session's own key
+    std::shared_ptr<const std::string> authorization;  // "Bearer ..." or null; swapped with std::atomic_store
+    AdaptiveRateLimiter rate_limiter;
+};
+
+struct SessionConfig {
+    std::string api_key;
+    std::string base_url = "https://api.licensechain.app";
+    std::chrono::milliseconds timeout{30000};
+    std::chrono::milliseconds max_queue_wait{1000};  // for a rate-limit token or a concurrency slot
+    std::string user_agent = "LicenseChain-CPP-SDK/1.0.0";
+    size_t threads = 0;
+    size_t max_queue_depth = 0;
+    size_t reserved_queue_depth = 0;   // of max_queue_depth, kept for Validation tasks
+    size_t reserved_threads = 1;       // extra executor threads that only run Validation tasks
+    RetryPolicy retry;
+    ConcurrencyLimitOptions concurrency;
+    CircuitBreakerOptions circuit_breaker;
+    size_t cache_capacity = 10000;
+    std::chrono::milliseconds cache_ttl{60000};
+    std::chrono::milliseconds cache_max_stale{3600000};
+};
+
+struct SessionMetrics {
+    uint64_t requests;
+    uint64_t failures;
+    uint64_t cache_hits;
+    uint64_t stale_hits;     // served from cache while the circuit was open
+    uint64_t throttled;      // refused locally by a rate or concurrency limit
+};
+
+// Everything the services share: the transport, the precomputed header
+// block, the executor and timer wheel, the retry scheduler, rate and
+// concurrency limiters, circuit breakers and the response cache. Services
+// hold a shared_ptr to one Session, so using all four costs the same as
+// using one.
+//
+// send() takes a request through the limiters and the endpoint's circuit
+// breaker to the transport, feeds the response back into them, and maps
+// error statuses to the SDK's exceptions. With a TokenManager attached, a
+// 401 refreshes the token (shared with any concurrent refresh) and the
+// request is sent once more with the new header. Validation requests take
+// concurrency slots at RequestPriority::Validation, so analytics and bulk
+// exports cannot hold every slot while license checks wait.
+class Session {
+public:
+    // Performs one HTTP exchange. Throwing anything other than a
+    // LicenseChainException is reported as a NetworkException.
+    using Transport = std::function<HttpResponse(const HttpRequest&)>;
+
+    Session(SessionConfig config, Transport transport);
+    ~Session();
+
+    Session(const Session&) = delete;
+    Session& operator=(const Session&) = delete;
+
+    HttpResponse send(const std::string& method, const std::string& endpoint, const std::string& body = "",
+                      const CancellationToken& token = {});
+    HttpResponse send(Tenant& tenant, const std::string& method, const std::string& endpoint,
+                      const std::string& body = "", const CancellationToken& token = {});
+    // GET through the response cache, partitioned by tenant. While the
+    // endpoint's circuit is open, a stale entry is served instead of failing.
+    std::string getCached(const std::string& endpoint, const CancellationToken& token = {});
+    std::string getCached(Tenant& tenant, const std::string& endpoint, const CancellationToken& token = {});
+
+    // Runs func on the executor with retries, see RetryScheduler.
+    template <typename Func>
+    auto submit(Func func, CancellationToken token = {}, RequestPriority priority = RequestPriority::Interactive) {
+        return retries_.submit(std::move(func), std::move(token), priority);
+    }
+
+    // Authenticate with refreshed bearer tokens instead of the API key.
+    void setTokenManager(std::shared_ptr<TokenManager> tokens);
+
+    const SessionConfig& config() const { return config_; }
+    const std::shared_ptr<const HeaderBlock>& headers() const { return headers_; }
+    Executor& executor() { return executor_; }
+    TimerWheel& timers() { return timers_; }
+    RetryScheduler& retries() { return retries_; }
+    AdaptiveRateLimiter& rateLimiter() { return default_tenant_.rate_limiter; }
+    ConcurrencyLimiter& concurrencyLimiter() { return concurrency_; }
+    CircuitBreakerRegistry& circuitBreakers() { return breakers_; }
+    ResponseCache<std::string>& cache() { return cache_; }
+    SessionMetrics metrics() const;
+
+    // Breaker key for an endpoint: its class and first path segment after
+    // any API version, so /v1/licenses/{id} share one breaker and /v1/apps
+    // has another.
+    static std::string breakerKey(EndpointClass cls, const std::string& endpoint);
+    static void throwForStatus(const HttpResponse& response);
+
+private:
+    struct Credentials {
+        std::shared_ptr<const std::string> authorization;
+        uint64_t generation = 0;
+    };
+    Credentials credentials(const Tenant& tenant) const;
+    HttpResponse exchange(const HttpRequest& request) const;
+
+    const SessionConfig config_;
+    const Transport transport_;
+    const std::shared_ptr<const HeaderBlock> headers_;
+    Tenant default_tenant_;
+    std::shared_ptr<TokenManager> tokens_;   // accessed only through std::atomic_load/atomic_store
+
+    Executor executor_;
+    TimerWheel timers_;
+    RetryScheduler retries_;
+    ConcurrencyLimiter concurrency_;
+    CircuitBreakerRegistry breakers_;
+    ResponseCache<std::string> cache_;
+
+    std::atomic<uint64_t> requests_{0};
+    std::atomic<uint64_t> failures_{0};
+    std::atomic<uint64_t> cache_hits_{0};
+    std::atomic<uint64_t> stale_hits_{0};
+    std::atomic<uint64_t> throttled_{0};
+};
+
+} // namespace LicenseChain
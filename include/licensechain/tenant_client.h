@@ -0,0 +1,66 @@
+#pragma once
+
+#include "cancellation.h"
+#include "session.h"
+#include <cstddef>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace LicenseChain {
+
+// One process serving many LicenseChain accounts.
+//
+// All tenants share a single Session: its transport and connection pool,
+// executor, timer wheel, concurrency limiter, circuit breakers and response
+// cache, including the JWKS document, which is the same for every account.
+// What each tenant owns is a Tenant: its id, its Authorization header and
+// its rate-limit buckets, since quotas are enforced per API key. Cached
+// responses are partitioned by tenant id, so one account never sees
+// another's data.
+class TenantClient {
+public:
+    // The config's api_key is not used; each tenant brings its own.
+    TenantClient(SessionConfig config, Session::Transport transport);
+
+    TenantClient(const TenantClient&) = delete;
+    TenantClient& operator=(const TenantClient&) = delete;
+
+    // Registers a tenant, or replaces its API key. Throws
+    // ConfigurationException for an empty id or key.
+    void addTenant(const std::string& tenantId, const std::string& apiKey);
+    // Requests already in flight for the tenant complete normally.
+    bool removeTenant(const std::string& tenantId);
+    bool hasTenant(const std::string& tenantId) const;
+    size_t tenantCount() const;
+    std::vector<std::string> tenantIds() const;
+
+    // As Session::send() and getCached(), with the tenant's credentials and
+    // rate limits. Throws NotFoundException for an unknown tenant.
+    HttpResponse send(const std::string& tenantId, const std::string& method, const std::string& endpoint,
+                      const std::string& body = "", const CancellationToken& token = {});
+    std::string getCached(const std::string& tenantId, const std::string& endpoint,
+                          const CancellationToken& token = {});
+
+    // The license-token signing keys, fetched once for all tenants. Sent
+    // without credentials: HttpRequest::authorization is null.
+    std::string jwks(const CancellationToken& token = {});
+
+    RateLimiterStats rateLimiterStats(const std::string& tenantId, EndpointClass cls) const;
+
+    Session& session() { return *session_; }
+
+    static constexpr const char* JWKS_ENDPOINT = "/v1/licenses/jwks";
+
+private:
+    std::shared_ptr<Tenant> find(const std::string& tenantId) const;
+
+    std::shared_ptr<Session> session_;
+
+    mutable std::shared_mutex mutex_;
+    std::unordered_map<std::string, std::shared_ptr<Tenant>> tenants_;
+};
+
+} // namespace LicenseChain
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+namespace LicenseChain {
+
+// Hashed timer wheel driven by one background thread.
+//
+// Scheduling and cancelling are O(1); each tick only visits one slot. Delays
+// are rounded up to whole ticks. Callbacks run on the wheel thread and must
+// be short: hand real work to an Executor.
+class TimerWheel {
+public:
+    using Task = std::function<void()>;
+
+    explicit TimerWheel(std::chrono::milliseconds tick = std::chrono::milliseconds(10), size_t slots = 512);
+    ~TimerWheel();
+
+    TimerWheel(const TimerWheel&) = delete;
+    TimerWheel& operator=(const TimerWheel&) = delete;
+
+    // Returns an ID for cancel(); 0 if the wheel has been shut down.
+    uint64_t schedule(std::chrono::milliseconds delay, Task task);
+    // True if the timer was pending and will not fire.
+    bool cancel(uint64_t id);
+
+    // Stops the thread; pending timers are dropped without running.
+    void shutdown();
+
+    size_t pending() const;
+    std::chrono::milliseconds tick() const { return tick_; }
+
+private:
+    struct Timer {
+        uint64_t id;
+        uint64_t rounds;
+        Task task;
+    };
+
+    void run();
+
+    std::chrono::milliseconds tick_;
+    std::vector<std::vector<Timer>> slots_;
+    size_t cursor_ = 0;
+    uint64_t next_id_ = 1;
+    std::unordered_set<uint64_t> live_;
+    bool stopping_ = false;
+    mutable std::mutex mutex_;
+    std::condition_variable wake_;
+    std::thread thread_;
+};
+
+} // namespace LicenseChain
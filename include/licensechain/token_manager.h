@@ -0,0 +1,79 @@
+#pragma once
+
+#include "executor.h"
+#include "retry.h"
+#include "timer_wheel.h"
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <string>
+
+namespace LicenseChain {
+
+struct AuthToken {
+    std::string access_token;
+    std::string refresh_token;
+    std::chrono::system_clock::time_point expires_at;
+};
+
+// Published, immutable view of the current credentials.
+struct AuthHeader {
+    std::string value;                                 // "Bearer <access token>"
+    std::chrono::steady_clock::time_point expires_at;
+    uint64_t generation;                               // increases with every refresh
+};
+
+struct TokenRefreshOptions {
+    double refresh_at = 0.8;                      // share of the lifetime after which to refresh
+    std::chrono::milliseconds min_margin{30000};  // but at least this long before expiry
+    RetryPolicy retry;                            // delays between failed refreshes
+};
+
+struct TokenManagerStats {
+    uint64_t generation;
+    uint64_t refreshes;
+    uint64_t failures;
+    uint64_t coalesced;   // refresh requests served by one already in flight
+};
+
+// Keeps the access token fresh without involving request threads.
+//
+// The current header is an immutable AuthHeader swapped in atomically, so
+// header() is a single atomic shared_ptr load and never waits on a refresh.
+// Before the token expires, a TimerWheel timer starts a refresh on the
+// Executor; failures are retried with the policy's backoff while the old
+// header stays in use. refresh() is also the reactive path after a 401: at
+// most one refresh runs at a time, and concurrent callers share its result.
+class TokenManager {
+public:
+    // Exchanges a refresh token for new credentials, e.g. by wrapping
+    // RefreshTokenAsync; runs on the executor and may throw.
+    using Refresher = std::function<AuthToken(const std::string& refreshToken)>;
+
+    TokenManager(Executor& executor, TimerWheel& timers, Refresher refresher, TokenRefreshOptions options = {});
+    ~TokenManager();
+
+    TokenManager(const TokenManager&) = delete;
+    TokenManager& operator=(const TokenManager&) = delete;
+
+    // Publishes credentials from a login and schedules their refresh.
+    void setToken(const AuthToken& token);
+
+    // Current header, or null before setToken().
+    std::shared_ptr<const AuthHeader> header() const;
+
+    // Refreshes now unless a refresh is already running, in which case its
+    // result is shared. With the generation of a header that was rejected,
+    // returns at once if a newer header has been published since.
+    std::shared_future<std::shared_ptr<const AuthHeader>> refresh(uint64_t staleGeneration = 0);
+
+    TokenManagerStats stats() const;
+
+private:
+    struct State;
+    std::shared_ptr<State> state_;
+};
+
+} // namespace LicenseChain
@@ -1,6 +1,9 @@
 #pragma once
 
+#include "retry.h"
 #include <string>
+#include <string_view>
+#include <charconv>
 #include <vector>
 #include <map>
 #include <chrono>
@@ -17,9 +20,14 @@ namespace LicenseChain {
 class Utils {
 public:
     // Validation functions
-    static bool validateEmail(const std::string& email);
-    static bool validateLicenseKey(const std::string& licenseKey);
-    static bool validateUuid(const std::string& uuid);
+    static bool validateEmail(std::string_view email);
+    static bool validateLicenseKey(std::string_view licenseKey);
+    static bool validateUuid(std::string_view uuid);
+    
+    // Batch validation; result[i] corresponds to input[i]. Keys and UUIDs are
+    // checked 16 bytes at a time where SSE2 is available.
+    static std::vector<bool> validateLicenseKeys(const std::vector<std::string_view>& licenseKeys);
+    static std::vector<bool> validateUuids(const std::vector<std::string_view>& uuids);
     static bool validateAmount(double amount);
     static bool validateCurrency(const std::string& currency);
     
@@ -31,6 +39,13 @@ public:
     static std::string generateLicenseKey();
     static std::string generateUuid();
     
+    // Bulk generation. The buffer overloads write `count` back-to-back values
+    // (32 characters per key, 36 per UUID) with no separators.
+    static std::vector<std::string> generateLicenseKeys(size_t count);
+    static std::vector<std::string> generateUuids(size_t count);
+    static void generateLicenseKeys(size_t count, char* out);
+    static void generateUuids(size_t count, char* out);
+    
     // String utilities
     static std::string capitalizeFirst(const std::string& text);
     static std::string toSnakeCase(const std::string& text);
@@ -43,7 +58,17 @@ public:
     static std::string formatDuration(int seconds);
     static std::string formatPrice(double price, const std::string& currency = "USD");
     static std::string formatTimestamp(const std::chrono::system_clock::time_point& timestamp);
-    static std::chrono::system_clock::time_point parseTimestamp(const std::string& timestamp);
+    static std::chrono::system_clock::time_point parseTimestamp(std::string_view timestamp);
+    
+    // Allocation-free RFC 3339 / ISO-8601 timestamp handling.
+    // formatTimestamp writes "YYYY-MM-DDTHH:MM:SS.mmmZ" (UTC, millisecond precision)
+    // into [first, last) following std::to_chars conventions.
+    // tryParseTimestamp accepts an optional fraction of up to nanosecond precision
+    // and a "Z" or "+HH:MM" / "-HH:MM" offset; input without an offset is taken as UTC.
+    static constexpr size_t TIMESTAMP_BUFFER_SIZE = 24;
+    static std::to_chars_result formatTimestamp(char* first, char* last,
+                                                const std::chrono::system_clock::time_point& timestamp);
+    static bool tryParseTimestamp(std::string_view timestamp, std::chrono::system_clock::time_point& result);
     
     // Validation helpers
     static void validateNotEmpty(const std::string& value, const std::string& fieldName);
@@ -60,6 +85,9 @@ public:
     // Crypto functions
     static std::string createWebhookSignature(const std::string& payload, const std::string& secret);
     static bool verifyWebhookSignature(const std::string& payload, const std::string& signature, const std::string& secret);
+    // Element i is true if items[i].second is a valid signature of items[i].first; spread across cores.
+    static std::vector<bool> verifyWebhookSignatures(const std::vector<std::pair<std::string_view, std::string_view>>& items,
+                                                     const std::string& secret);
     static std::string sha256(const std::string& data);
     static std::string sha1(const std::string& data);
     static std::string md5(const std::string& data);
@@ -67,6 +95,23 @@ public:
     // Encoding/Decoding
     static std::string base64Encode(const std::string& data);
     static std::string base64Decode(const std::string& data);
+    static std::string base64UrlEncode(const std::string& data);
+    static std::string base64UrlDecode(const std::string& data);
+    
+    // Buffer-based codecs (SSSE3 kernels with scalar fallback).
+    // Encoders write base64EncodedLength(length) characters (2 * length for hex)
+    // to `out` and return the count. Decoders write at most
+    // base64DecodedMaxLength(size) bytes (size / 2 for hex) and return false on
+    // invalid input. base64url output is unpadded, as used for JWT segments;
+    // both base64 decoders accept input with or without padding.
+    static size_t base64EncodedLength(size_t length, bool padding = true);
+    static size_t base64DecodedMaxLength(size_t length);
+    static size_t base64Encode(const uint8_t* data, size_t length, char* out);
+    static size_t base64UrlEncode(const uint8_t* data, size_t length, char* out);
+    static bool base64Decode(std::string_view data, uint8_t* out, size_t& outLength);
+    static bool base64UrlDecode(std::string_view data, uint8_t* out, size_t& outLength);
+    static void toHex(const uint8_t* data, size_t length, char* out);
+    static bool fromHex(std::string_view hex, uint8_t* out);
     static std::string urlEncode(const std::string& data);
     static std::string urlDecode(const std::string& data);
     
@@ -76,7 +121,7 @@ public:
     static std::map<std::string, std::string> jsonDeserialize(const std::string& jsonString);
     
     // URL utilities
-    static bool isValidUrl(const std::string& urlString);
+    static bool isValidUrl(std::string_view urlString);
     
     // Time utilities
     static std::chrono::system_clock::time_point getCurrentTimestamp();
@@ -96,33 +141,35 @@ public:
     // Random generation
     static std::string generateRandomString(size_t length, const std::string& characters = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789");
     static std::vector<uint8_t> generateRandomBytes(size_t length);
+    static void generateRandomBytes(uint8_t* out, size_t length);
     
-    // Retry logic
+    // Retry logic. Makes up to maxRetries attempts, retrying only errors
+    // RetryPolicy::isRetryable accepts and sleeping a decorrelated-jitter delay
+    // (starting at initialDelayMs) in between. Blocks the calling thread; use
+    // RetryScheduler to retry without holding one.
     template<typename Func>
     static auto retryWithBackoff(Func func, int maxRetries = 3, int initialDelayMs = 1000) -> decltype(func()) {
-        int delay = initialDelayMs;
-        std::exception_ptr lastException;
+        RetryPolicy policy;
+        policy.max_attempts = maxRetries;
+        policy.base_delay = std::chrono::milliseconds(initialDelayMs);
+        policy.max_delay = policy.base_delay * (int64_t{1} << std::min(std::max(maxRetries, 1), 10));
         
-        for (int i = 0; i < maxRetries; ++i) {
+        std::chrono::milliseconds delay(0);
+        for (int attempt = 1;; ++attempt) {
             try {
                 return func();
             } catch (...) {
-                lastException = std::current_exception();
-                if (i < maxRetries - 1) {
-                    std::this_thread::sleep_for(std::chrono::milliseconds(delay));
-                    delay *= 2; // Exponential backoff
-                }
+                if (attempt >= maxRetries || !RetryPolicy::isRetryable(std::current_exception())) throw;
             }
+            delay = policy.nextDelay(delay);
+            std::this_thread::sleep_for(delay);
         }
-        
-        std::rethrow_exception(lastException);
     }
     
     // Sleep utility
     static void sleep(int milliseconds);
 
 private:
-    static std::mt19937& getRandomGenerator();
     static std::string toHex(const std::vector<uint8_t>& data);
     static std::vector<uint8_t> fromHex(const std::string& hex);
 };
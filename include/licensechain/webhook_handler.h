@@ -2,20 +2,71 @@
 
 #include "models.h"
 #include "exceptions.h"
+#include "executor.h"
+#include "replay_guard.h"
+#include "webhook_inbox.h"
+#include "webhook_verifier.h"
+#include <atomic>
+#include <chrono>
 #include <string>
+#include <string_view>
 #include <functional>
-#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
 
 namespace LicenseChain {
 
+// Outcome of receiving one webhook delivery.
+enum class WebhookResult {
+    Accepted,
+    InvalidTimestamp,
+    InvalidSignature,
+    InvalidPayload,
+    Rejected,   // async dispatch queue full
+    Duplicate,  // event ID already seen within the replay window
+    Shed,       // refused by load shedding; the sender should retry later
+};
+
+// Order in which event types are shed under load, lowest first.
+enum class EventPriority {
+    Low,
+    Normal,
+    High,
+    Critical,
+};
+
+struct LoadSheddingOptions {
+    // Hard bound on events accepted but not yet finished; Critical events are
+    // refused only at this bound.
+    size_t max_in_flight = 10000;
+    // Receive-to-completion latency that counts as full pressure.
+    std::chrono::milliseconds target_latency{1000};
+};
+
+struct LoadSheddingMetrics {
+    size_t in_flight;
+    std::chrono::nanoseconds latency;   // smoothed receive-to-completion time
+    double pressure;                    // max of in-flight and latency ratios
+    uint64_t shed[4];                   // indexed by EventPriority
+};
+
 class WebhookHandler {
 public:
     using EventCallback = std::function<void(const WebhookEvent&)>;
+    // Receives a view into the payload; no copy of the event is made unless an
+    // EventCallback is registered for the same type.
+    using EventViewCallback = std::function<void(const WebhookEventView&)>;
     
     WebhookHandler(const std::string& secret);
+    ~WebhookHandler();
     
-    // Event registration
+    // Event registration. The callback and priority tables are not
+    // synchronized: register callbacks and set priorities during setup, before
+    // deliveries arrive (WebhookServer::start, enableAsyncDispatch).
     void onEvent(const std::string& eventType, EventCallback callback);
+    void onEventView(const std::string& eventType, EventViewCallback callback);
     void onLicenseCreated(EventCallback callback);
     void onLicenseUpdated(EventCallback callback);
     void onLicenseRevoked(EventCallback callback);
@@ -27,32 +78,146 @@ public:
     void onWebhookUpdated(EventCallback callback);
     void onWebhookDeleted(EventCallback callback);
     
-    // Webhook processing
-    bool processWebhook(const std::string& payload, const std::string& signature, const std::string& timestamp);
+    // Webhook processing. Both the timestamp header and the signed payload
+    // timestamp (or created_at) must be present and within the tolerance;
+    // otherwise the delivery is refused as InvalidTimestamp.
+    bool processWebhook(std::string_view payload, std::string_view signature, std::string_view timestamp);
+    WebhookResult receiveWebhook(std::string_view payload, std::string_view signature, std::string_view timestamp);
     WebhookEvent parseWebhookEvent(const std::string& payload);
     
+    // Single pass over the payload; fills `view` with slices of `payload`.
+    // Returns false if the payload is not a JSON object.
+    static bool parseWebhookEventView(std::string_view payload, WebhookEventView& view);
+    
     // Signature verification
     bool verifySignature(const std::string& payload, const std::string& signature, const std::string& timestamp);
     
-    // Event handling
-    void handleEvent(const WebhookEvent& event);
+    // Index of the active secret whose HMAC matches the signature, or -1. All
+    // secrets are computed in a single pass over the payload.
+    int matchSecret(std::string_view payload, std::string_view signature) const;
+    
+    // Signature check of many stored deliveries against every active secret,
+    // spread across cores; e.g. when draining a backlog. No timestamp check.
+    std::vector<bool> verifySignatures(const std::vector<WebhookVerifier::SignedPayload>& items, size_t threads = 0) const;
+    
+    // Event handling. Returns false only when async dispatch is enabled and
+    // the event was rejected because the queue is full.
+    bool handleEvent(const WebhookEvent& event);
+    bool handleEvent(const WebhookEventView& event);
+    
+    // Async dispatch. Callbacks run on a pool of `workers` threads instead of
+    // the receiving thread. Events with the same ordering key (the license_id,
+    // then user_id, then id field of the event data) are delivered in arrival
+    // order; other events run in parallel. With a non-zero maxQueueDepth a
+    // full queue either blocks the receiver or rejects the event. Register
+    // callbacks before enabling; disabling drains queued events.
+    void enableAsyncDispatch(size_t workers = 0, size_t maxQueueDepth = 0, bool blockWhenFull = false);
+    void disableAsyncDispatch();
+    bool isAsyncDispatchEnabled() const;
+    ExecutorMetrics getDispatchMetrics() const;
+    
+    // Replay protection. Event IDs are remembered for twice the timestamp
+    // tolerance (covering clock skew in either direction) and repeats are
+    // reported as Duplicate without running callbacks. Memory is fixed by
+    // expectedEventsPerSecond; see ReplayGuard. setTolerance() resets it.
+    void enableReplayProtection(size_t expectedEventsPerSecond = 1000);
+    void disableReplayProtection();
+    bool isReplayProtectionEnabled() const;
+    
+    // Durable inbox. Accepted deliveries are appended to the inbox before
+    // receiveWebhook returns and acknowledged once their callbacks finish
+    // without throwing. replayInbox() is meant for startup: it dispatches the
+    // entries a previous process left unacknowledged and returns how many,
+    // stopping early if the async queue rejects one. A callback that throws
+    // only fails its own entry; once an entry has been replayed
+    // maxReplayAttempts times it is passed to the dead-letter callback, if
+    // any, and acknowledged so its segment can be reclaimed.
+    using DeadLetterCallback = std::function<void(const WebhookInbox::Entry&)>;
+    void setInbox(std::shared_ptr<WebhookInbox> inbox);
+    std::shared_ptr<WebhookInbox> getInbox() const;
+    void setMaxReplayAttempts(uint32_t maxReplayAttempts);
+    void onDeadLetter(DeadLetterCallback callback);
+    size_t replayInbox();
+    
+    // Load shedding. Pressure is the larger of in-flight events over
+    // max_in_flight and smoothed latency over target_latency. Low, Normal and
+    // High events are refused with WebhookResult::Shed from pressure 0.5, 0.75
+    // and 0.9 respectively; Critical events only at max_in_flight. Built-in
+    // defaults: license.revoked Critical, other license events High,
+    // webhook.* Low, everything else Normal. Shedding can be enabled, retuned
+    // or disabled while deliveries are running; setEventPriority is setup-only
+    // like onEvent.
+    void enableLoadShedding(const LoadSheddingOptions& options = {});
+    void disableLoadShedding();
+    void setEventPriority(const std::string& eventType, EventPriority priority);
+    EventPriority getEventPriority(std::string_view eventType) const;
+    LoadSheddingMetrics getLoadSheddingMetrics() const;
+    
+    // Key used to order async delivery; empty if the data has none.
+    static std::string_view orderingKey(const WebhookEventView& event);
     
     // Configuration
     void setSecret(const std::string& secret);
     void setTolerance(int toleranceSeconds);
     
+    // Secret rotation. Secrets are kept in order (matchSecret reports positions
+    // in this order); replacing the set is atomic with respect to concurrent
+    // processWebhook calls.
+    void setSecrets(const std::vector<std::string>& secrets);
+    void addSecret(const std::string& secret);
+    void removeSecret(const std::string& secret);
+    std::vector<std::string> getSecrets() const;
+    
     // Utility methods
     static std::string createSignature(const std::string& payload, const std::string& secret);
-    static bool verifyTimestamp(const std::string& timestamp, int toleranceSeconds = 300);
+    static bool verifyTimestamp(std::string_view timestamp, int toleranceSeconds = 300);
     static std::string getEventType(const std::string& payload);
 
 private:
-    std::string secret_;
+    struct Keyring {
+        std::vector<std::string> secrets;
+        std::vector<WebhookVerifier> verifiers;
+    };
+    
+    std::shared_ptr<const Keyring> keyring_;
+    std::mutex keyring_mutex_;
     int tolerance_seconds_;
-    std::map<std::string, std::vector<EventCallback>> event_callbacks_;
+    struct Callbacks {
+        std::vector<EventCallback> owning;
+        std::vector<EventViewCallback> views;
+        EventPriority priority = EventPriority::Normal;
+    };
+    
+    // Dispatch table indexed by dense event type ID. Built-in types have fixed
+    // IDs found by perfect hash; other types get the next ID on registration.
+    std::vector<Callbacks> event_callbacks_;
+    std::vector<std::pair<std::string, size_t>> custom_event_ids_;
+    
+    std::shared_ptr<Executor> dispatcher_;
+    bool block_when_full_ = false;
+    std::shared_ptr<ReplayGuard> replay_guard_;
+    std::shared_ptr<WebhookInbox> inbox_;
+    uint32_t max_replay_attempts_ = 5;
+    DeadLetterCallback dead_letter_callback_;
+    
+    std::shared_ptr<const LoadSheddingOptions> shedding_options_;
+    std::atomic<size_t> in_flight_{0};
+    std::atomic<int64_t> latency_ns_{0};
+    std::atomic<uint64_t> shed_counts_[4]{};
+    size_t replay_events_per_second_ = 0;
     
     void registerDefaultCallbacks();
-    void callEventCallbacks(const std::string& eventType, const WebhookEvent& event);
+    void installKeyring(std::vector<std::string> secrets);
+    std::shared_ptr<const Keyring> keyring() const;
+    size_t registerEventType(const std::string& eventType);
+    const Callbacks* findCallbacks(std::string_view eventType) const;
+    double loadPressure(const LoadSheddingOptions& options) const;
+    bool admit(EventPriority priority, const LoadSheddingOptions& options) const;
+    void finishEvent(std::chrono::steady_clock::time_point admitted, bool completed);
+    void deadLetter(WebhookInbox& inbox, const WebhookInbox::Entry& entry);
+    bool dispatch(const WebhookEventView& view, const WebhookEvent* event,
+                  const std::shared_ptr<WebhookInbox>& inbox = nullptr, uint64_t entry = 0);
+    void callEventCallbacks(const WebhookEventView& view, const WebhookEvent* event);
     std::string extractTimestamp(const std::string& payload);
     bool isEventType(const std::string& eventType, const std::string& payload);
 };
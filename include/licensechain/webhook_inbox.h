@@ -0,0 +1,98 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace LicenseChain {
+
+// Durable, append-only log of accepted webhook deliveries.
+//
+// Entries are written into memory-mapped segment files and are on disk when
+// append() returns. Concurrent appends share one msync: the first caller to
+// find no flush in progress syncs everything written so far while the others
+// wait for it, so the sync cost is spread across a burst. acknowledge()
+// appends a marker without waiting for the disk; if it is lost in a crash the
+// entry is delivered again. Segments whose entries are all acknowledged are
+// deleted. On construction the directory is scanned and unacknowledged
+// entries are available from pending() for replay. recordAttempt() counts
+// delivery attempts across restarts, so an entry that keeps failing can be
+// given up on instead of pinning its segment forever.
+class WebhookInbox {
+public:
+    struct Entry {
+        uint64_t sequence;
+        std::string payload;
+        std::string signature;
+        uint32_t attempts;   // recorded by recordAttempt(), including previous runs
+    };
+
+    explicit WebhookInbox(const std::string& directory, size_t segmentSize = 64 * 1024 * 1024);
+    ~WebhookInbox();
+
+    WebhookInbox(const WebhookInbox&) = delete;
+    WebhookInbox& operator=(const WebhookInbox&) = delete;
+
+    // Returns the entry's sequence number once it is durable. Throws
+    // LicenseChainException("STORAGE_ERROR") if the log cannot be written.
+    uint64_t append(std::string_view payload, std::string_view signature);
+    void acknowledge(uint64_t sequence);
+    // Notes a delivery attempt for an unacknowledged entry; like
+    // acknowledge(), it does not wait for the disk. Returns the new count.
+    uint32_t recordAttempt(uint64_t sequence);
+
+    // Unacknowledged entries in append order.
+    std::vector<Entry> pending() const;
+    size_t pendingCount() const;
+
+    uint64_t commits() const;
+    size_t segmentCount() const;
+
+private:
+    struct Segment {
+        std::string path;
+        int fd = -1;
+        char* data = nullptr;
+        size_t size = 0;
+        uint64_t id = 0;
+        size_t unacknowledged = 0;
+        ~Segment();
+    };
+
+    struct Location {
+        Segment* segment;
+        size_t offset;
+        uint32_t attempts = 0;
+    };
+
+    void recover();
+    void scan(Segment& segment, bool active);
+    std::unique_ptr<Segment> openSegment(uint64_t id, size_t size, bool create);
+    void rotate(size_t needed);
+    void writeRecord(uint8_t type, uint64_t sequence, std::string_view payload, std::string_view signature);
+    void releaseSegments();
+
+    std::string directory_;
+    size_t segment_size_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable flushed_;
+    std::deque<std::unique_ptr<Segment>> segments_;
+    size_t offset_ = 0;                 // write position in the active segment
+    size_t sync_offset_ = 0;            // start of the unsynced range in the active segment
+    uint64_t next_sequence_ = 1;
+    uint64_t next_segment_id_ = 1;
+    uint64_t durable_sequence_ = 0;
+    bool flushing_ = false;
+    uint64_t commits_ = 0;
+    std::map<uint64_t, Location> unacknowledged_;
+};
+
+} // namespace LicenseChain
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "webhook_handler.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace LicenseChain {
+
+struct WebhookServerConfig {
+    std::string bind_address = "0.0.0.0";
+    uint16_t port = 8080;                 // 0 picks a free port; see WebhookServer::port()
+    std::string path = "/webhook";        // empty accepts any path
+    std::string signature_header = "X-LicenseChain-Signature";
+    std::string timestamp_header = "X-LicenseChain-Timestamp";
+    size_t threads = 1;                   // event loops, each with its own SO_REUSEPORT listener
+    size_t max_connections = 1024;        // across all loops; extra connections are closed on accept
+    size_t max_body_size = 1 << 20;
+    size_t buffer_size = 16 * 1024;       // initial size of pooled connection buffers
+    int idle_timeout_ms = 30000;
+    int retry_after_seconds = 1;          // Retry-After sent with 503 when events are shed or the queue is full
+};
+
+struct WebhookServerStats {
+    size_t connections;
+    uint64_t accepted_connections;
+    uint64_t refused_connections;
+    uint64_t requests;
+    uint64_t accepted_events;
+    uint64_t rejected_events;
+};
+
+// Minimal HTTP/1.1 receiver in front of WebhookHandler::receiveWebhook.
+//
+// Each event loop owns an epoll set and a pool of connection buffers. A
+// request is read into the connection's buffer and handed to the handler as
+// slices of that buffer, and the response is one of a fixed set of static
+// messages, so a delivery costs no allocation once the pool is warm.
+// Keep-alive and pipelining are supported; chunked bodies are not.
+// Linux only: start() throws ConfigurationException elsewhere.
+class WebhookServer {
+public:
+    WebhookServer(WebhookHandler& handler, WebhookServerConfig config = {});
+    ~WebhookServer();
+
+    WebhookServer(const WebhookServer&) = delete;
+    WebhookServer& operator=(const WebhookServer&) = delete;
+
+    // Binds and starts the event loops. Throws NetworkException on failure.
+    void start();
+    // Closes all connections and joins the event loops.
+    void stop();
+
+    bool isRunning() const { return running_.load(); }
+    uint16_t port() const { return port_; }
+    WebhookServerStats stats() const;
+
+private:
+    class Loop;
+
+    WebhookHandler& handler_;
+    WebhookServerConfig config_;
+    std::string unavailable_response_;
+    std::vector<std::unique_ptr<Loop>> loops_;
+    std::atomic<bool> running_{false};
+    uint16_t port_ = 0;
+
+    std::atomic<size_t> connections_{0};
+    std::atomic<uint64_t> accepted_connections_{0};
+    std::atomic<uint64_t> refused_connections_{0};
+    std::atomic<uint64_t> requests_{0};
+    std::atomic<uint64_t> accepted_events_{0};
+    std::atomic<uint64_t> rejected_events_{0};
+};
+
+} // namespace LicenseChain
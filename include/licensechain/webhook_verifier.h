@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+struct evp_md_ctx_st;
+
+namespace LicenseChain {
+
+// HMAC-SHA256 webhook signature verifier bound to one secret.
+//
+// The inner and outer pad states are hashed once at construction; each
+// message then only copies those states and hashes the body, so verifying a
+// payload costs no key schedule. A verifier is immutable after construction
+// and may be shared between threads; each thread opens its own Stream.
+class WebhookVerifier {
+public:
+    static constexpr size_t DIGEST_SIZE = 32;
+    
+    // A payload and its signature header.
+    using SignedPayload = std::pair<std::string_view, std::string_view>;
+
+    // Incremental computation for one message. Feed the body in any number of
+    // chunks, then call digest() or verify() exactly once.
+    class Stream {
+    public:
+        Stream(Stream&& other) noexcept;
+        Stream& operator=(Stream&& other) noexcept;
+        Stream(const Stream&) = delete;
+        Stream& operator=(const Stream&) = delete;
+        ~Stream();
+
+        void update(const void* data, size_t length);
+        void update(std::string_view chunk) { update(chunk.data(), chunk.size()); }
+
+        void digest(uint8_t out[DIGEST_SIZE]);
+        // Compares against a hex signature, with or without a "sha256=" prefix.
+        bool verify(std::string_view signature);
+        bool verify(const uint8_t expected[DIGEST_SIZE]);
+
+    private:
+        friend class WebhookVerifier;
+        Stream(evp_md_ctx_st* inner, const evp_md_ctx_st* outer);
+
+        evp_md_ctx_st* ctx_;
+        const evp_md_ctx_st* outer_;
+    };
+
+    explicit WebhookVerifier(std::string_view secret);
+    WebhookVerifier(const WebhookVerifier& other);
+    WebhookVerifier(WebhookVerifier&& other) noexcept;
+    WebhookVerifier& operator=(WebhookVerifier other) noexcept;
+    ~WebhookVerifier();
+
+    Stream begin() const;
+
+    std::string sign(std::string_view payload) const;
+    bool verify(std::string_view payload, std::string_view signature) const;
+
+    // Verifies many payloads across `threads` threads (0: one per core; small
+    // batches run on the calling thread). Element i is true if item i's
+    // signature matches. Each thread reuses one digest context throughout.
+    std::vector<bool> verifyBatch(const SignedPayload* items, size_t count, size_t threads = 0) const;
+    std::vector<bool> verifyBatch(const std::vector<SignedPayload>& items, size_t threads = 0) const;
+    // As above, true if the signature matches any of the verifiers.
+    static std::vector<bool> verifyBatch(const std::vector<WebhookVerifier>& verifiers,
+                                         const SignedPayload* items, size_t count, size_t threads = 0);
+    
+    // Index of the first verifier whose HMAC matches the signature, or -1.
+    // The payload is read once: each chunk is fed to every verifier before
+    // moving on, so rotation with several secrets does not re-read the body.
+    static int findMatch(const std::vector<WebhookVerifier>& verifiers,
+                         std::string_view payload, std::string_view signature);
+
+    // Decodes a hex signature header ("sha256=" prefix optional) into raw bytes.
+    static bool parseSignature(std::string_view signature, uint8_t out[DIGEST_SIZE]);
+
+private:
+    static std::vector<bool> verifyBatch(const WebhookVerifier* verifiers, size_t verifierCount,
+                                         const SignedPayload* items, size_t count, size_t threads);
+    
+    evp_md_ctx_st* inner_;
+    evp_md_ctx_st* outer_;
+};
+
+} // namespace LicenseChain
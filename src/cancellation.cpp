@@ -0,0 +1,138 @@
+#include "licensechain/cancellation.h"
+#include "licensechain/exceptions.h"
+#include <algorithm>
+
+namespace LicenseChain {
+
+// CancellationToken::State
+
+CancellationToken::State::~State() {
+    if (timers && timer != 0) timers->cancel(timer);
+    if (parent && parent_callback != 0) CancellationToken(parent).removeCallback(parent_callback);
+}
+
+void CancellationToken::State::cancel(Reason why) {
+    int expected = static_cast<int>(Reason::None);
+    if (!reason.compare_exchange_strong(expected, static_cast<int>(why))) return;
+    std::vector<std::pair<uint64_t, std::function<void()>>> pending;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        pending.swap(callbacks);
+    }
+    for (auto& [id, callback] : pending) {
+        try {
+            callback();
+        } catch (...) {
+        }
+    }
+}
+
+// CancellationToken
+
+bool CancellationToken::isCancelled() const {
+    if (!state_) return false;
+    if (state_->reason.load(std::memory_order_acquire) != static_cast<int>(Reason::None)) return true;
+    return Clock::now().time_since_epoch().count() >= state_->deadline.load(std::memory_order_relaxed);
+}
+
+bool CancellationToken::hasDeadline() const {
+    return deadline() != Clock::time_point::max();
+}
+
+CancellationToken::Clock::time_point CancellationToken::deadline() const {
+    if (!state_) return Clock::time_point::max();
+    return Clock::time_point(Clock::duration(state_->deadline.load(std::memory_order_relaxed)));
+}
+
+CancellationToken::Clock::duration CancellationToken::remaining() const {
+    const Clock::time_point end = deadline();
+    if (end == Clock::time_point::max()) return Clock::duration::max();
+    return std::max(end - Clock::now(), Clock::duration::zero());
+}
+
+std::exception_ptr CancellationToken::error() const {
+    if (!state_) return nullptr;
+    const int reason = state_->reason.load(std::memory_order_acquire);
+    if (reason == static_cast<int>(Reason::Cancelled)) {
+        return std::make_exception_ptr(CancelledException("Operation was cancelled"));
+    }
+    if (reason == static_cast<int>(Reason::DeadlineExceeded) || isCancelled()) {
+        return std::make_exception_ptr(DeadlineExceededException("Deadline exceeded"));
+    }
+    return nullptr;
+}
+
+void CancellationToken::throwIfCancelled() const {
+    if (auto e = error()) std::rethrow_exception(e);
+}
+
+uint64_t CancellationToken::onCancel(std::function<void()> callback) const {
+    if (!state_) return 0;
+    {
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        if (state_->reason.load(std::memory_order_acquire) == static_cast<int>(Reason::None)) {
+            const uint64_t id = state_->next_id++;
+            state_->callbacks.emplace_back(id, std::move(callback));
+            return id;
+        }
+    }
+    callback();
+    return 0;
+}
+
+void CancellationToken::removeCallback(uint64_t id) const {
+    if (!state_ || id == 0) return;
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    auto& callbacks = state_->callbacks;
+    auto it = std::find_if(callbacks.begin(), callbacks.end(), [id](const auto& entry) { return entry.first == id; });
+    if (it != callbacks.end()) callbacks.erase(it);
+}
+
+// CancellationSource
+
+CancellationSource::CancellationSource() : state_(std::make_shared<CancellationToken::State>()) {}
+
+CancellationSource::CancellationSource(Clock::time_point deadline) : CancellationSource() {
+    state_->deadline.store(deadline.time_since_epoch().count(), std::memory_order_relaxed);
+}
+
+CancellationSource::CancellationSource(const CancellationToken& parent, Clock::time_point deadline)
+    : CancellationSource(std::min(deadline, parent.deadline())) {
+    if (!parent.state_) return;
+    std::weak_ptr<CancellationToken::State> weak = state_;
+    std::weak_ptr<CancellationToken::State> weakParent = parent.state_;
+    const uint64_t id = parent.onCancel([weak, weakParent] {
+        auto child = weak.lock();
+        auto parentState = weakParent.lock();
+        if (child && parentState) {
+            const auto reason = static_cast<CancellationToken::Reason>(parentState->reason.load(std::memory_order_acquire));
+            child->cancel(reason == CancellationToken::Reason::None ? CancellationToken::Reason::Cancelled : reason);
+        }
+    });
+    if (id != 0) {
+        state_->parent = parent.state_;
+        state_->parent_callback = id;
+    }
+}
+
+void CancellationSource::cancel() {
+    state_->cancel(CancellationToken::Reason::Cancelled);
+}
+
+void CancellationSource::cancelAfter(TimerWheel& timers, std::chrono::milliseconds timeout) {
+    const Clock::time_point deadline = Clock::now() + timeout;
+    Clock::rep current = state_->deadline.load(std::memory_order_relaxed);
+    while (deadline.time_since_epoch().count() < current &&
+           !state_->deadline.compare_exchange_weak(current, deadline.time_since_epoch().count(), std::memory_order_relaxed)) {
+    }
+    std::weak_ptr<CancellationToken::State> weak = state_;
+    const uint64_t timer = timers.schedule(timeout, [weak] {
+        if (auto state = weak.lock()) state->cancel(CancellationToken::Reason::DeadlineExceeded);
+    });
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    if (state_->timers && state_->timer != 0) state_->timers->cancel(state_->timer);
+    state_->timers = &timers;
+    state_->timer = timer;
+}
+
+} // namespace LicenseChain
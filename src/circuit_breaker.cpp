@@ -0,0 +1,171 @@
+#include "licensechain/circuit_breaker.h"
+#include "licensechain/retry.h"
+#include <algorithm>
+
+namespace LicenseChain {
+
+namespace {
+
+bool isCancelled(const std::exception_ptr& error) {
+    if (!error) return false;
+    try {
+        std::rethrow_exception(error);
+    } catch (const CancelledException&) {
+        return true;
+    } catch (...) {
+        return false;
+    }
+}
+
+} // namespace
+
+// CircuitBreaker
+
+CircuitBreaker::CircuitBreaker(CircuitBreakerOptions options)
+    : options_(options),
+      bucket_width_(std::max<Clock::duration>(options.window / BUCKETS, std::chrono::milliseconds(1))) {
+    if (options_.failure_rate_threshold <= 0 || options_.failure_rate_threshold > 1) {
+        throw ConfigurationException("Circuit breaker failure rate threshold must be in (0, 1]");
+    }
+}
+
+CircuitBreaker::Bucket& CircuitBreaker::currentBucket(Clock::time_point now) {
+    const int64_t epoch = now.time_since_epoch() / bucket_width_;
+    Bucket& bucket = buckets_[static_cast<size_t>(epoch) % BUCKETS];
+    if (bucket.epoch != epoch) bucket = Bucket{epoch, 0, 0};
+    return bucket;
+}
+
+void CircuitBreaker::totals(Clock::time_point now, uint64_t& successes, uint64_t& failures) const {
+    const int64_t epoch = now.time_since_epoch() / bucket_width_;
+    successes = failures = 0;
+    for (const Bucket& bucket : buckets_) {
+        if (bucket.epoch <= epoch - static_cast<int64_t>(BUCKETS)) continue;
+        successes += bucket.successes;
+        failures += bucket.failures;
+    }
+}
+
+void CircuitBreaker::open(Clock::time_point now) {
+    state_ = CircuitState::Open;
+    opened_at_ = now;
+    ++opened_;
+}
+
+bool CircuitBreaker::allowRequest() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const Clock::time_point now = Clock::now();
+    if (state_ == CircuitState::Open) {
+        if (now - opened_at_ < options_.open_duration) {
+            ++short_circuited_;
+            return false;
+        }
+        state_ = CircuitState::HalfOpen;
+        probes_started_ = 0;
+        probes_succeeded_ = 0;
+    }
+    if (state_ == CircuitState::HalfOpen) {
+        if (probes_started_ >= options_.half_open_probes) {
+            ++short_circuited_;
+            return false;
+        }
+        ++probes_started_;
+    }
+    return true;
+}
+
+void CircuitBreaker::recordSuccess() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const Clock::time_point now = Clock::now();
+    if (state_ == CircuitState::HalfOpen) {
+        if (++probes_succeeded_ < options_.half_open_probes) return;
+        // Recovered: start the window afresh so old failures cannot reopen it.
+        state_ = CircuitState::Closed;
+        buckets_.fill(Bucket{});
+    }
+    ++currentBucket(now).successes;
+}
+
+void CircuitBreaker::recordFailure() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const Clock::time_point now = Clock::now();
+    if (state_ == CircuitState::HalfOpen) {
+        open(now);
+        return;
+    }
+    ++currentBucket(now).failures;
+    if (state_ != CircuitState::Closed) return;
+
+    uint64_t successes, failures;
+    totals(now, successes, failures);
+    const uint64_t total = successes + failures;
+    if (total >= options_.minimum_requests &&
+        static_cast<double>(failures) >= options_.failure_rate_threshold * static_cast<double>(total)) {
+        open(now);
+    }
+}
+
+void CircuitBreaker::abandon() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (state_ == CircuitState::HalfOpen && probes_started_ > probes_succeeded_) --probes_started_;
+}
+
+void CircuitBreaker::record(const std::exception_ptr& error) {
+    if (isCancelled(error)) {
+        abandon();
+    } else if (isFailure(error)) {
+        recordFailure();
+    } else {
+        recordSuccess();
+    }
+}
+
+bool CircuitBreaker::isFailure(const std::exception_ptr& error) {
+    if (!error) return false;
+    try {
+        std::rethrow_exception(error);
+    } catch (const RateLimitException&) {
+        return false;
+    } catch (const DeadlineExceededException&) {
+        // Not retried, since the caller's time is up, but the endpoint was too slow.
+        return true;
+    } catch (...) {
+        return RetryPolicy::isRetryable(std::current_exception());
+    }
+}
+
+CircuitState CircuitBreaker::state() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return state_;
+}
+
+CircuitBreakerMetrics CircuitBreaker::metrics() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    CircuitBreakerMetrics m;
+    m.state = state_;
+    totals(Clock::now(), m.successes, m.failures);
+    m.short_circuited = short_circuited_;
+    m.opened = opened_;
+    return m;
+}
+
+// CircuitBreakerRegistry
+
+CircuitBreakerRegistry::CircuitBreakerRegistry(CircuitBreakerOptions options) : options_(options) {
+    // Reject bad options here rather than on first use of an endpoint.
+    CircuitBreaker validate(options_);
+}
+
+CircuitBreaker& CircuitBreakerRegistry::forEndpoint(const std::string& endpoint) {
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        auto it = breakers_.find(endpoint);
+        if (it != breakers_.end()) return *it->second;
+    }
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    auto& breaker = breakers_[endpoint];
+    if (!breaker) breaker = std::make_unique<CircuitBreaker>(options_);
+    return *breaker;
+}
+
+} // namespace LicenseChain
@@ -0,0 +1,155 @@
+#include "licensechain/concurrency_limiter.h"
+#include "licensechain/exceptions.h"
+#include <algorithm>
+#include <cmath>
+
+namespace LicenseChain {
+
+namespace {
+
+constexpr double SHORT_RTT_WEIGHT = 0.1;
+constexpr double BASELINE_DRIFT = 0.0005;   // per sample, so the baseline can rise if the upstream got slower
+
+} // namespace
+
+// Permit
+
+ConcurrencyLimiter::Permit::Permit(Permit&& other) noexcept
+    : limiter_(other.limiter_), start_(other.start_) {
+    other.limiter_ = nullptr;
+}
+
+ConcurrencyLimiter::Permit& ConcurrencyLimiter::Permit::operator=(Permit&& other) noexcept {
+    if (this != &other) {
+        release(Outcome::Ignored);
+        limiter_ = other.limiter_;
+        start_ = other.start_;
+        other.limiter_ = nullptr;
+    }
+    return *this;
+}
+
+ConcurrencyLimiter::Permit::~Permit() {
+    release(Outcome::Ignored);
+}
+
+void ConcurrencyLimiter::Permit::release(Outcome outcome) {
+    if (!limiter_) return;
+    limiter_->release(start_, outcome);
+    limiter_ = nullptr;
+}
+
+// ConcurrencyLimiter
+
+ConcurrencyLimiter::ConcurrencyLimiter(ConcurrencyLimitOptions options) : options_(options) {
+    if (options_.min_limit == 0 || options_.min_limit > options_.max_limit) {
+        throw ConfigurationException("Concurrency limits must satisfy 0 < min_limit <= max_limit");
+    }
+    if (options_.reserved_share < 0 || options_.reserved_share >= 1) {
+        throw ConfigurationException("Reserved concurrency share must be in [0, 1)");
+    }
+    limit_ = static_cast<double>(std::clamp(options_.initial_limit, options_.min_limit, options_.max_limit));
+}
+
+size_t ConcurrencyLimiter::reservedLocked() const {
+    const size_t limit = static_cast<size_t>(limit_);
+    if (options_.reserved_share == 0 || limit < 2) return 0;
+    return std::clamp(static_cast<size_t>(limit_ * options_.reserved_share), size_t(1), limit - 1);
+}
+
+bool ConcurrencyLimiter::availableLocked(RequestPriority priority) const {
+    const size_t p = static_cast<size_t>(priority);
+    for (size_t higher = 0; higher < p; ++higher) {
+        if (waiting_[higher] > 0) return false;
+    }
+    const size_t limit = static_cast<size_t>(limit_);
+    return in_flight_ < (priority == RequestPriority::Validation ? limit : limit - reservedLocked());
+}
+
+ConcurrencyLimiter::Permit ConcurrencyLimiter::grantLocked() {
+    ++in_flight_;
+    ++acquired_;
+    return Permit(this, Clock::now());
+}
+
+std::optional<ConcurrencyLimiter::Permit> ConcurrencyLimiter::tryAcquire(RequestPriority priority) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!availableLocked(priority)) {
+        ++rejected_;
+        return std::nullopt;
+    }
+    return grantLocked();
+}
+
+std::optional<ConcurrencyLimiter::Permit> ConcurrencyLimiter::acquire(std::chrono::milliseconds maxWait,
+                                                                      RequestPriority priority) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (availableLocked(priority)) return grantLocked();
+
+    size_t& waiting = waiting_[static_cast<size_t>(priority)];
+    ++waiting;
+    const bool granted = available_.wait_for(lock, maxWait, [&] { return availableLocked(priority); });
+    --waiting;
+    if (!granted) {
+        ++rejected_;
+        // Lower priorities may have been held back by this waiter.
+        available_.notify_all();
+        return std::nullopt;
+    }
+    return grantLocked();
+}
+
+void ConcurrencyLimiter::release(Clock::time_point start, Outcome outcome) {
+    const double rtt = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const size_t inFlight = in_flight_--;
+
+        if (outcome == Outcome::Dropped) {
+            ++dropped_;
+            limit_ = std::max(static_cast<double>(options_.min_limit), limit_ * options_.backoff_ratio);
+        } else if (outcome == Outcome::Success) {
+            if (baseline_rtt_ == 0) {
+                short_rtt_ = baseline_rtt_ = rtt;
+            } else {
+                short_rtt_ += (rtt - short_rtt_) * SHORT_RTT_WEIGHT;
+                baseline_rtt_ = std::min(rtt, baseline_rtt_ * (1 + BASELINE_DRIFT));
+            }
+
+            const double gradient = std::clamp(options_.rtt_tolerance * baseline_rtt_ / short_rtt_, 0.5, 1.0);
+            double estimate = limit_ * gradient;
+            // Only grow when the limit is actually what holds callers back.
+            // Reserved slots do not count: at a small limit they are most of
+            // it, and other traffic could never fill half.
+            const double usable = limit_ - static_cast<double>(reservedLocked());
+            if (static_cast<double>(inFlight) >= usable / 2) estimate += std::sqrt(limit_);
+            limit_ = limit_ * (1 - options_.smoothing) + estimate * options_.smoothing;
+            limit_ = std::clamp(limit_, static_cast<double>(options_.min_limit), static_cast<double>(options_.max_limit));
+        }
+    }
+    // Waiters differ in priority and headroom, so a single wakeup could go to
+    // one that still has to wait.
+    available_.notify_all();
+}
+
+size_t ConcurrencyLimiter::limit() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return static_cast<size_t>(limit_);
+}
+
+ConcurrencyLimiterMetrics ConcurrencyLimiter::metrics() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ConcurrencyLimiterMetrics m;
+    m.limit = static_cast<size_t>(limit_);
+    m.reserved = reservedLocked();
+    m.in_flight = in_flight_;
+    std::copy(waiting_.begin(), waiting_.end(), m.waiting);
+    m.short_rtt = std::chrono::nanoseconds(static_cast<int64_t>(short_rtt_));
+    m.baseline_rtt = std::chrono::nanoseconds(static_cast<int64_t>(baseline_rtt_));
+    m.acquired = acquired_;
+    m.rejected = rejected_;
+    m.dropped = dropped_;
+    return m;
+}
+
+} // namespace LicenseChain
@@ -0,0 +1,209 @@
+#include "licensechain/executor.h"
+#include <algorithm>
+
+namespace LicenseChain {
+
+Executor::Executor(size_t threads, size_t maxQueueDepth, size_t reservedDepth, size_t reservedThreads)
+    : max_queue_depth_(maxQueueDepth), reserved_depth_(std::min(reservedDepth, maxQueueDepth)) {
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    workers_.reserve(threads);
+    for (size_t i = 0; i < threads; ++i) workers_.push_back(std::make_unique<Worker>());
+    for (auto& worker : workers_) {
+        Worker* w = worker.get();
+        w->thread = std::thread([this, w] { run(*w); });
+    }
+    validation_threads_.reserve(reservedThreads);
+    for (size_t i = 0; i < reservedThreads; ++i) validation_threads_.emplace_back([this] { runValidation(); });
+}
+
+Executor::~Executor() {
+    shutdown();
+}
+
+bool Executor::post(Task task, RequestPriority priority) {
+    return submit(workerFor(next_worker_.fetch_add(1, std::memory_order_relaxed), priority), std::move(task), priority, true);
+}
+
+bool Executor::post(uint64_t key, Task task, RequestPriority priority) {
+    return submit(*workers_[key % workers_.size()], std::move(task), priority, true);
+}
+
+bool Executor::tryPost(Task task, RequestPriority priority) {
+    return submit(workerFor(next_worker_.fetch_add(1, std::memory_order_relaxed), priority), std::move(task), priority, false);
+}
+
+bool Executor::tryPost(uint64_t key, Task task, RequestPriority priority) {
+    return submit(*workers_[key % workers_.size()], std::move(task), priority, false);
+}
+
+Executor::Worker& Executor::workerFor(size_t index, RequestPriority priority) {
+    if (priority == RequestPriority::Validation && !validation_threads_.empty()) return validation_;
+    return *workers_[index % workers_.size()];
+}
+
+void Executor::shutdown() {
+    if (stopping_.exchange(true)) return;
+    {
+        std::lock_guard<std::mutex> lock(space_mutex_);
+        space_available_.notify_all();
+    }
+    for (auto& worker : workers_) {
+        {
+            std::lock_guard<std::mutex> lock(worker->mutex);
+            worker->ready.notify_all();
+        }
+        if (worker->thread.joinable()) worker->thread.join();
+    }
+    {
+        std::lock_guard<std::mutex> lock(validation_.mutex);
+        validation_.ready.notify_all();
+    }
+    for (auto& thread : validation_threads_) {
+        if (thread.joinable()) thread.join();
+    }
+}
+
+ExecutorMetrics Executor::metrics() const {
+    ExecutorMetrics m;
+    m.queue_length = queued_.load(std::memory_order_relaxed);
+    m.submitted = submitted_.load(std::memory_order_relaxed);
+    m.completed = completed_.load(std::memory_order_relaxed);
+    m.rejected = rejected_.load(std::memory_order_relaxed);
+    m.failed = failed_.load(std::memory_order_relaxed);
+    const uint64_t done = m.completed + m.failed;
+    m.average_queue_latency = std::chrono::nanoseconds(done ? total_queue_ns_.load() / static_cast<int64_t>(done) : 0);
+    m.max_queue_latency = std::chrono::nanoseconds(max_queue_ns_.load(std::memory_order_relaxed));
+    m.average_run_time = std::chrono::nanoseconds(done ? total_run_ns_.load() / static_cast<int64_t>(done) : 0);
+    return m;
+}
+
+bool Executor::submit(Worker& worker, Task task, RequestPriority priority, bool wait) {
+    if (stopping_.load(std::memory_order_acquire) || !reserve(priority, wait)) {
+        rejected_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        // Checked again under the lock the worker exits under: shutdown() may
+        // have started since, and the worker may already have left.
+        if (stopping_.load(std::memory_order_acquire)) {
+            release();
+            rejected_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        worker.queues[static_cast<size_t>(priority)].push_back(Item{std::move(task), std::chrono::steady_clock::now()});
+    }
+    worker.ready.notify_one();
+    submitted_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool Executor::reserve(RequestPriority priority, bool wait) {
+    if (max_queue_depth_ == 0) {
+        queued_.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    const size_t depth = priority == RequestPriority::Validation ? max_queue_depth_ : max_queue_depth_ - reserved_depth_;
+    auto tryReserve = [this, depth] {
+        size_t current = queued_.load(std::memory_order_relaxed);
+        while (current < depth) {
+            if (queued_.compare_exchange_weak(current, current + 1, std::memory_order_relaxed)) return true;
+        }
+        return false;
+    };
+    if (tryReserve()) return true;
+    if (!wait) return false;
+
+    std::unique_lock<std::mutex> lock(space_mutex_);
+    space_waiters_.fetch_add(1);
+    bool reserved = false;
+    space_available_.wait(lock, [&] {
+        return stopping_.load(std::memory_order_acquire) || (reserved = tryReserve());
+    });
+    space_waiters_.fetch_sub(1);
+    return reserved;
+}
+
+void Executor::release() {
+    queued_.fetch_sub(1, std::memory_order_relaxed);
+    if (space_waiters_.load() > 0) {
+        // Waiters have different depth limits; the one woken must be able to use the slot.
+        std::lock_guard<std::mutex> lock(space_mutex_);
+        space_available_.notify_all();
+    }
+}
+
+void Executor::run(Worker& worker) {
+    for (;;) {
+        Item item;
+        // Shared Validation work first: this worker may be the first to free up.
+        if (!takeValidation(item)) {
+            std::unique_lock<std::mutex> lock(worker.mutex);
+            std::deque<Item>* queue = nullptr;
+            worker.ready.wait(lock, [&] {
+                for (auto& q : worker.queues) {
+                    if (!q.empty()) {
+                        queue = &q;
+                        return true;
+                    }
+                }
+                return stopping_.load(std::memory_order_acquire);
+            });
+            if (!queue) return;
+            item = std::move(queue->front());
+            queue->pop_front();
+        }
+        release();
+        execute(item);
+    }
+}
+
+void Executor::runValidation() {
+    auto& queue = validation_.queues[static_cast<size_t>(RequestPriority::Validation)];
+    for (;;) {
+        Item item;
+        {
+            std::unique_lock<std::mutex> lock(validation_.mutex);
+            validation_.ready.wait(lock, [&] { return !queue.empty() || stopping_.load(std::memory_order_acquire); });
+            if (queue.empty()) return;
+            item = std::move(queue.front());
+            queue.pop_front();
+        }
+        release();
+        execute(item);
+    }
+}
+
+bool Executor::takeValidation(Item& item) {
+    if (validation_threads_.empty()) return false;
+    auto& queue = validation_.queues[static_cast<size_t>(RequestPriority::Validation)];
+    std::lock_guard<std::mutex> lock(validation_.mutex);
+    if (queue.empty()) return false;
+    item = std::move(queue.front());
+    queue.pop_front();
+    return true;
+}
+
+void Executor::execute(Item& item) {
+    using Clock = std::chrono::steady_clock;
+    const auto started = Clock::now();
+    const int64_t waited = std::chrono::duration_cast<std::chrono::nanoseconds>(started - item.enqueued).count();
+    total_queue_ns_.fetch_add(waited, std::memory_order_relaxed);
+    int64_t max = max_queue_ns_.load(std::memory_order_relaxed);
+    while (waited > max && !max_queue_ns_.compare_exchange_weak(max, waited, std::memory_order_relaxed)) {
+    }
+
+    try {
+        item.task();
+        completed_.fetch_add(1, std::memory_order_relaxed);
+    } catch (...) {
+        failed_.fetch_add(1, std::memory_order_relaxed);
+    }
+    total_run_ns_.fetch_add(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - started).count(),
+        std::memory_order_relaxed);
+}
+
+} // namespace LicenseChain
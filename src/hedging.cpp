@@ -0,0 +1,83 @@
+#include "licensechain/hedging.h"
+#include <algorithm>
+#include <cmath>
+
+namespace LicenseChain {
+
+namespace {
+
+constexpr double FIRST_BUCKET_NS = 100000.0;  // 100 µs
+constexpr double BUCKET_GROWTH = 1.25;
+
+} // namespace
+
+// LatencyTracker
+
+LatencyTracker::LatencyTracker(uint64_t decayInterval) : decay_interval_(std::max<uint64_t>(decayInterval, 1)) {}
+
+size_t LatencyTracker::bucketFor(std::chrono::nanoseconds latency) {
+    const double ns = static_cast<double>(latency.count());
+    if (ns <= FIRST_BUCKET_NS) return 0;
+    const double bucket = std::ceil(std::log(ns / FIRST_BUCKET_NS) / std::log(BUCKET_GROWTH));
+    return std::min(static_cast<size_t>(bucket), BUCKETS - 1);
+}
+
+std::chrono::nanoseconds LatencyTracker::bucketLimit(size_t bucket) {
+    return std::chrono::nanoseconds(static_cast<int64_t>(FIRST_BUCKET_NS * std::pow(BUCKET_GROWTH, static_cast<double>(bucket))));
+}
+
+void LatencyTracker::record(std::chrono::nanoseconds latency) {
+    counts_[bucketFor(latency)].fetch_add(1, std::memory_order_relaxed);
+    if (since_decay_.fetch_add(1, std::memory_order_relaxed) + 1 < decay_interval_) return;
+    since_decay_.store(0, std::memory_order_relaxed);
+    for (auto& count : counts_) count.store(count.load(std::memory_order_relaxed) / 2, std::memory_order_relaxed);
+}
+
+std::chrono::nanoseconds LatencyTracker::percentile(double quantile, uint64_t minimumSamples) const {
+    uint64_t snapshot[BUCKETS];
+    uint64_t total = 0;
+    for (size_t i = 0; i < BUCKETS; ++i) {
+        snapshot[i] = counts_[i].load(std::memory_order_relaxed);
+        total += snapshot[i];
+    }
+    if (total == 0 || total < minimumSamples) return std::chrono::nanoseconds(0);
+
+    const double target = std::clamp(quantile, 0.0, 1.0) * static_cast<double>(total);
+    uint64_t seen = 0;
+    for (size_t i = 0; i < BUCKETS; ++i) {
+        seen += snapshot[i];
+        if (static_cast<double>(seen) >= target && snapshot[i] > 0) return bucketLimit(i);
+    }
+    return bucketLimit(BUCKETS - 1);
+}
+
+uint64_t LatencyTracker::count() const {
+    uint64_t total = 0;
+    for (const auto& count : counts_) total += count.load(std::memory_order_relaxed);
+    return total;
+}
+
+// RequestHedger
+
+RequestHedger::RequestHedger(Executor& executor, TimerWheel& timers, HedgingPolicy policy,
+                             std::shared_ptr<RetryBudget> budget)
+    : executor_(executor), timers_(timers), policy_(policy),
+      budget_(budget ? std::move(budget) : std::make_shared<RetryBudget>(0.05, 5.0)) {}
+
+std::chrono::milliseconds RequestHedger::hedgeDelay() const {
+    const auto estimate = latencies_.percentile(policy_.percentile);
+    if (estimate.count() == 0) return policy_.initial_delay;
+    const auto delay = std::chrono::ceil<std::chrono::milliseconds>(estimate);
+    return std::clamp(delay, policy_.min_delay, std::max(policy_.min_delay, policy_.max_delay));
+}
+
+HedgingStats RequestHedger::stats() const {
+    HedgingStats s;
+    s.calls = calls_.load(std::memory_order_relaxed);
+    s.hedges = hedges_.load(std::memory_order_relaxed);
+    s.hedge_wins = hedge_wins_.load(std::memory_order_relaxed);
+    s.budget_exhausted = budget_exhausted_.load(std::memory_order_relaxed);
+    return s;
+}
+
+} // namespace LicenseChain
@@ -0,0 +1,353 @@
+#include "licensechain/model_decoder.h"
+#include "licensechain/utils.h"
+#include "licensechain/exceptions.h"
+#include <nlohmann/json.hpp>
+#include <charconv>
+#include <cstdint>
+
+namespace LicenseChain {
+
+namespace {
+
+using Json = nlohmann::json;
+
+// Field setters shared by the std and pmr model variants. Both variants use the
+// same member names, so one template per model covers the two of them.
+template<typename S>
+void assignString(S& target, const std::string& value) {
+    target.assign(value.data(), value.size());
+}
+
+template<typename S>
+void assignOptional(std::optional<S>& target, const std::string& value, const S& sibling) {
+    target.emplace(value.data(), value.size(), sibling.get_allocator());
+}
+
+// Unparseable timestamps leave the field at its default rather than failing
+// the whole response.
+inline void assignTimestamp(std::chrono::system_clock::time_point& target, const std::string& value) {
+    Utils::tryParseTimestamp(value, target);
+}
+
+inline void assignTimestamp(std::optional<std::chrono::system_clock::time_point>& target, const std::string& value) {
+    std::chrono::system_clock::time_point parsed;
+    if (Utils::tryParseTimestamp(value, parsed)) target = parsed;
+}
+
+template<typename Map>
+void insertMetadata(Map& metadata, const std::string& key, const std::string& value) {
+    metadata.emplace(std::string_view(key), std::string_view(value));
+}
+
+struct NoNumberFields {
+    template<typename Record>
+    static bool number(Record&, const std::string&, double) { return false; }
+};
+
+struct NoListFields {
+    template<typename Record>
+    static bool listItem(Record&, const std::string&, const std::string&) { return false; }
+};
+
+struct NoMetadata {
+    template<typename Record>
+    static bool metadata(Record&, const std::string&, const std::string&) { return false; }
+};
+
+struct WithMetadata {
+    template<typename Record>
+    static bool metadata(Record& record, const std::string& key, const std::string& value) {
+        insertMetadata(record.metadata, key, value);
+        return true;
+    }
+};
+
+struct LicenseFields : NoNumberFields, NoListFields, WithMetadata {
+    template<typename Record>
+    static bool string(Record& r, const std::string& key, const std::string& value) {
+        if (key == "id") assignString(r.id, value);
+        else if (key == "user_id") assignString(r.user_id, value);
+        else if (key == "product_id") assignString(r.product_id, value);
+        else if (key == "license_key") assignString(r.license_key, value);
+        else if (key == "status") assignString(r.status, value);
+        else if (key == "created_at") assignTimestamp(r.created_at, value);
+        else if (key == "updated_at") assignTimestamp(r.updated_at, value);
+        else if (key == "expires_at") assignTimestamp(r.expires_at, value);
+        else return false;
+        return true;
+    }
+};
+
+struct UserFields : NoNumberFields, NoListFields, WithMetadata {
+    template<typename Record>
+    static bool string(Record& r, const std::string& key, const std::string& value) {
+        if (key == "id") assignString(r.id, value);
+        else if (key == "email") assignString(r.email, value);
+        else if (key == "name") assignString(r.name, value);
+        else if (key == "created_at") assignTimestamp(r.created_at, value);
+        else if (key == "updated_at") assignTimestamp(r.updated_at, value);
+        else return false;
+        return true;
+    }
+};
+
+struct ProductFields : NoListFields, WithMetadata {
+    template<typename Record>
+    static bool string(Record& r, const std::string& key, const std::string& value) {
+        if (key == "id") assignString(r.id, value);
+        else if (key == "name") assignString(r.name, value);
+        else if (key == "description") assignOptional(r.description, value, r.name);
+        else if (key == "currency") assignString(r.currency, value);
+        else if (key == "created_at") assignTimestamp(r.created_at, value);
+        else if (key == "updated_at") assignTimestamp(r.updated_at, value);
+        else return false;
+        return true;
+    }
+
+    template<typename Record>
+    static bool number(Record& r, const std::string& key, double value) {
+        if (key != "price") return false;
+        r.price = value;
+        return true;
+    }
+};
+
+struct WebhookFields : NoNumberFields, NoMetadata {
+    template<typename Record>
+    static bool string(Record& r, const std::string& key, const std::string& value) {
+        if (key == "id") assignString(r.id, value);
+        else if (key == "url") assignString(r.url, value);
+        else if (key == "secret") assignOptional(r.secret, value, r.url);
+        else if (key == "created_at") assignTimestamp(r.created_at, value);
+        else if (key == "updated_at") assignTimestamp(r.updated_at, value);
+        else return false;
+        return true;
+    }
+
+    template<typename Record>
+    static bool listItem(Record& r, const std::string& key, const std::string& value) {
+        if (key != "events") return false;
+        r.events.emplace_back(std::string_view(value));
+        return true;
+    }
+};
+
+// Sinks hand out the record the reader should fill next and receive the
+// pagination counters of list responses.
+template<typename Record>
+struct SingleSink {
+    Record& record;
+
+    Record& next() { return record; }
+    void counter(const std::string&, std::int64_t) {}
+};
+
+template<typename Response>
+struct ListSink {
+    Response& response;
+
+    auto& next() { return response.data.emplace_back(); }
+
+    void counter(const std::string& key, std::int64_t value) {
+        if (key == "total") response.total = static_cast<int>(value);
+        else if (key == "page") response.page = static_cast<int>(value);
+        else if (key == "limit") response.limit = static_cast<int>(value);
+    }
+};
+
+// SAX reader for a record object, either at the top level (depth 1) or as an
+// element of the top-level "data" array (depth 3). Containers nested inside a
+// record are routed to the metadata map or a string list; anything deeper or
+// unknown is skipped without being materialised.
+template<typename Fields, typename Sink>
+class RecordReader {
+public:
+    RecordReader(Sink& sink, int recordDepth) : sink_(sink), record_depth_(recordDepth) {}
+
+    bool null() { return true; }
+    bool boolean(bool value) { return scalar(value ? "true" : "false", value ? 1 : 0, false); }
+    bool number_integer(Json::number_integer_t value) { return integer(value); }
+    bool number_unsigned(Json::number_unsigned_t value) { return integer(static_cast<std::int64_t>(value)); }
+    bool number_float(Json::number_float_t value, const Json::string_t& text) {
+        if (depth_ == record_depth_ && record_) {
+            Fields::number(*record_, key_, value);
+        } else if (depth_ == record_depth_ + 1 && nested_ == Nested::Metadata && record_) {
+            Fields::metadata(*record_, nested_key_, text);
+        }
+        return true;
+    }
+    bool string(Json::string_t& value) {
+        if (depth_ == record_depth_ && record_) {
+            Fields::string(*record_, key_, value);
+        } else if (depth_ == record_depth_ + 1 && record_) {
+            if (nested_ == Nested::Metadata) Fields::metadata(*record_, nested_key_, value);
+            else if (nested_ == Nested::List) Fields::listItem(*record_, key_, value);
+        }
+        return true;
+    }
+    bool binary(Json::binary_t&) { return true; }
+
+    bool start_object(std::size_t) {
+        ++depth_;
+        if (depth_ == record_depth_ && (record_depth_ == 1 || in_data_)) {
+            record_ = &sink_.next();
+        } else if (depth_ == record_depth_ + 1 && record_) {
+            nested_ = key_ == "metadata" ? Nested::Metadata : Nested::Skip;
+        }
+        return true;
+    }
+    bool end_object() {
+        if (depth_ == record_depth_) record_ = nullptr;
+        else if (depth_ == record_depth_ + 1) nested_ = Nested::None;
+        --depth_;
+        return true;
+    }
+    bool start_array(std::size_t) {
+        ++depth_;
+        if (depth_ == 2 && record_depth_ == 3 && top_key_ == "data") {
+            in_data_ = true;
+        } else if (depth_ == record_depth_ + 1 && record_) {
+            nested_ = Nested::List;
+        }
+        return true;
+    }
+    bool end_array() {
+        if (depth_ == 2) in_data_ = false;
+        else if (depth_ == record_depth_ + 1) nested_ = Nested::None;
+        --depth_;
+        return true;
+    }
+    bool key(Json::string_t& value) {
+        if (depth_ == record_depth_) key_.assign(value);
+        else if (depth_ == record_depth_ + 1 && nested_ == Nested::Metadata) nested_key_.assign(value);
+        else if (depth_ == 1) top_key_.assign(value);
+        return true;
+    }
+    bool parse_error(std::size_t position, const std::string&, const nlohmann::detail::exception& ex) {
+        throw LicenseChainException("DECODE_ERROR",
+                                    "Malformed JSON at byte " + std::to_string(position) + ": " + ex.what());
+    }
+
+private:
+    enum class Nested { None, Metadata, List, Skip };
+
+    bool integer(std::int64_t value) {
+        if (depth_ == 1 && record_depth_ == 3) {
+            sink_.counter(top_key_, value);
+            return true;
+        }
+        char buffer[24];
+        auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+        return scalar(std::string(buffer, result.ptr), static_cast<double>(value), true);
+    }
+
+    bool scalar(const std::string& text, double value, bool numeric) {
+        if (depth_ == record_depth_ && record_ && numeric) {
+            Fields::number(*record_, key_, value);
+        } else if (depth_ == record_depth_ + 1 && nested_ == Nested::Metadata && record_) {
+            Fields::metadata(*record_, nested_key_, text);
+        }
+        return true;
+    }
+
+    Sink& sink_;
+    int record_depth_;
+    int depth_ = 0;
+    bool in_data_ = false;
+    Nested nested_ = Nested::None;
+    std::string top_key_;
+    std::string key_;
+    std::string nested_key_;
+    typename std::remove_reference<decltype(std::declval<Sink&>().next())>::type* record_ = nullptr;
+};
+
+template<typename Fields, typename Sink>
+void run(std::string_view json, Sink& sink, int recordDepth) {
+    RecordReader<Fields, Sink> reader(sink, recordDepth);
+    Json::sax_parse(json.begin(), json.end(), &reader);
+}
+
+template<typename Fields, typename Record>
+Record decodeOne(std::string_view json, Record record) {
+    SingleSink<Record> sink{record};
+    run<Fields>(json, sink, 1);
+    return record;
+}
+
+template<typename Fields, typename Response>
+Response decodeList(std::string_view json, Response response) {
+    response.total = 0;
+    response.page = 0;
+    response.limit = 0;
+    ListSink<Response> sink{response};
+    run<Fields>(json, sink, 3);
+    return response;
+}
+
+} // namespace
+
+License ModelDecoder::decodeLicense(std::string_view json) {
+    return decodeOne<LicenseFields>(json, License{});
+}
+
+LicenseListResponse ModelDecoder::decodeLicenseList(std::string_view json) {
+    return decodeList<LicenseFields>(json, LicenseListResponse{});
+}
+
+User ModelDecoder::decodeUser(std::string_view json) {
+    return decodeOne<UserFields>(json, User{});
+}
+
+UserListResponse ModelDecoder::decodeUserList(std::string_view json) {
+    return decodeList<UserFields>(json, UserListResponse{});
+}
+
+Product ModelDecoder::decodeProduct(std::string_view json) {
+    return decodeOne<ProductFields>(json, Product{});
+}
+
+ProductListResponse ModelDecoder::decodeProductList(std::string_view json) {
+    return decodeList<ProductFields>(json, ProductListResponse{});
+}
+
+Webhook ModelDecoder::decodeWebhook(std::string_view json) {
+    return decodeOne<WebhookFields>(json, Webhook{});
+}
+
+WebhookListResponse ModelDecoder::decodeWebhookList(std::string_view json) {
+    return decodeList<WebhookFields>(json, WebhookListResponse{});
+}
+
+pmr::License ModelDecoder::decodeLicense(std::string_view json, std::pmr::memory_resource* resource) {
+    return decodeOne<LicenseFields>(json, pmr::License(resource));
+}
+
+pmr::LicenseListResponse ModelDecoder::decodeLicenseList(std::string_view json, std::pmr::memory_resource* resource) {
+    return decodeList<LicenseFields>(json, pmr::LicenseListResponse(resource));
+}
+
+pmr::User ModelDecoder::decodeUser(std::string_view json, std::pmr::memory_resource* resource) {
+    return decodeOne<UserFields>(json, pmr::User(resource));
+}
+
+pmr::UserListResponse ModelDecoder::decodeUserList(std::string_view json, std::pmr::memory_resource* resource) {
+    return decodeList<UserFields>(json, pmr::UserListResponse(resource));
+}
+
+pmr::Product ModelDecoder::decodeProduct(std::string_view json, std::pmr::memory_resource* resource) {
+    return decodeOne<ProductFields>(json, pmr::Product(resource));
+}
+
+pmr::ProductListResponse ModelDecoder::decodeProductList(std::string_view json, std::pmr::memory_resource* resource) {
+    return decodeList<ProductFields>(json, pmr::ProductListResponse(resource));
+}
+
+pmr::Webhook ModelDecoder::decodeWebhook(std::string_view json, std::pmr::memory_resource* resource) {
+    return decodeOne<WebhookFields>(json, pmr::Webhook(resource));
+}
+
+pmr::WebhookListResponse ModelDecoder::decodeWebhookList(std::string_view json, std::pmr::memory_resource* resource) {
+    return decodeList<WebhookFields>(json, pmr::WebhookListResponse(resource));
+}
+
+} // namespace LicenseChain
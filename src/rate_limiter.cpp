@@ -0,0 +1,203 @@
+#include "licensechain/rate_limiter.h"
+#include "licensechain/exceptions.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <thread>
+
+namespace LicenseChain {
+
+namespace {
+
+using Seconds = std::chrono::duration<double>;
+
+constexpr double BACKOFF_FACTOR = 0.8;      // rate kept after an unexplained 429
+constexpr double RECOVERY_PER_SECOND = 0.01; // share of the configured rate regained per second
+constexpr double MIN_RATE_SHARE = 0.05;     // floor for the backed-off rate
+constexpr double MAX_WAIT_SECONDS = 86400;  // cap on server-requested waits
+
+const std::string* findHeader(const std::map<std::string, std::string>& headers, const char* name) {
+    for (const auto& [key, value] : headers) {
+        size_t i = 0;
+        while (i < key.size() && name[i] != '\0' &&
+               std::tolower(static_cast<unsigned char>(key[i])) == std::tolower(static_cast<unsigned char>(name[i]))) {
+            ++i;
+        }
+        if (i == key.size() && name[i] == '\0') return &value;
+    }
+    return nullptr;
+}
+
+std::optional<double> headerNumber(const std::map<std::string, std::string>& headers, const char* name) {
+    const std::string* value = findHeader(headers, name);
+    if (!value || value->empty()) return std::nullopt;
+    char* end = nullptr;
+    const double number = std::strtod(value->c_str(), &end);
+    if (end == value->c_str() || !std::isfinite(number) || number < 0) return std::nullopt;
+    return number;
+}
+
+// A wait in seconds, capped so that converting it to a duration cannot overflow.
+std::optional<double> headerSeconds(const std::map<std::string, std::string>& headers, const char* name) {
+    const auto seconds = headerNumber(headers, name);
+    if (!seconds) return std::nullopt;
+    return std::min(*seconds, MAX_WAIT_SECONDS);
+}
+
+// X-RateLimit-Reset is either seconds until the reset or a Unix timestamp.
+std::optional<double> secondsUntilReset(const std::map<std::string, std::string>& headers) {
+    auto reset = headerNumber(headers, "X-RateLimit-Reset");
+    if (!reset) return std::nullopt;
+    if (*reset > 1e9) {
+        const double now = Seconds(std::chrono::system_clock::now().time_since_epoch()).count();
+        return std::clamp(*reset - now, 0.0, MAX_WAIT_SECONDS);
+    }
+    return std::min(*reset, MAX_WAIT_SECONDS);
+}
+
+AdaptiveRateLimiter::Clock::duration toDuration(double seconds) {
+    return std::chrono::duration_cast<AdaptiveRateLimiter::Clock::duration>(Seconds(seconds));
+}
+
+} // namespace
+
+AdaptiveRateLimiter::AdaptiveRateLimiter() {
+    setLimit(EndpointClass::Validation, {50.0, 50.0});
+    setLimit(EndpointClass::Read, {20.0, 20.0});
+    setLimit(EndpointClass::Write, {10.0, 10.0});
+    setLimit(EndpointClass::Analytics, {2.0, 5.0});
+}
+
+void AdaptiveRateLimiter::setLimit(EndpointClass cls, RateLimit limit) {
+    if (limit.requests_per_second <= 0 || limit.burst < 1) {
+        throw ConfigurationException("Rate limit must be positive with a burst of at least one request");
+    }
+    Bucket& bucket = buckets_[static_cast<size_t>(cls)];
+    std::lock_guard<std::mutex> lock(bucket.mutex);
+    bucket.configured = limit;
+    bucket.rate = limit.requests_per_second;
+    bucket.tokens = std::min(bucket.tokens, limit.burst);
+    bucket.paced_until = {};
+}
+
+RateLimit AdaptiveRateLimiter::getLimit(EndpointClass cls) const {
+    const Bucket& bucket = buckets_[static_cast<size_t>(cls)];
+    std::lock_guard<std::mutex> lock(bucket.mutex);
+    return bucket.configured;
+}
+
+void AdaptiveRateLimiter::refill(Bucket& bucket, Clock::time_point now) const {
+    // No tokens accrue while the server has told us to wait.
+    const Clock::time_point from = std::max(bucket.updated, bucket.blocked_until);
+    if (now <= from) return;
+    const double elapsed = Seconds(now - from).count();
+    if (bucket.paced_until != Clock::time_point{} && now >= bucket.paced_until) {
+        // The server's window has reset; pace from the configured rate until told otherwise.
+        bucket.rate = bucket.configured.requests_per_second;
+        bucket.paced_until = {};
+    } else if (now >= bucket.paced_until && bucket.rate < bucket.configured.requests_per_second) {
+        bucket.rate = std::min(bucket.configured.requests_per_second,
+                               bucket.rate + bucket.configured.requests_per_second * RECOVERY_PER_SECOND * elapsed);
+    }
+    bucket.tokens = std::min(bucket.configured.burst, bucket.tokens + elapsed * bucket.rate);
+    bucket.updated = now;
+}
+
+std::optional<AdaptiveRateLimiter::Clock::duration> AdaptiveRateLimiter::reserve(EndpointClass cls,
+                                                                                std::chrono::milliseconds maxWait) {
+    Bucket& bucket = buckets_[static_cast<size_t>(cls)];
+    std::lock_guard<std::mutex> lock(bucket.mutex);
+    const Clock::time_point now = Clock::now();
+    refill(bucket, now);
+
+    // Tokens go negative while requests are queued; each waits its turn.
+    Clock::time_point ready = std::max(now, bucket.blocked_until);
+    if (bucket.tokens < 1.0) ready += toDuration((1.0 - bucket.tokens) / bucket.rate);
+    const Clock::duration wait = ready - now;
+    if (wait > maxWait) {
+        ++bucket.rejected;
+        return std::nullopt;
+    }
+    bucket.tokens -= 1.0;
+    ++bucket.granted;
+    if (wait > Clock::duration::zero()) ++bucket.delayed;
+    return wait;
+}
+
+bool AdaptiveRateLimiter::tryAcquire(EndpointClass cls) {
+    return reserve(cls, std::chrono::milliseconds(0)).has_value();
+}
+
+bool AdaptiveRateLimiter::acquire(EndpointClass cls, std::chrono::milliseconds maxWait) {
+    const auto wait = reserve(cls, maxWait);
+    if (!wait) return false;
+    if (*wait > Clock::duration::zero()) std::this_thread::sleep_for(*wait);
+    return true;
+}
+
+void AdaptiveRateLimiter::acquireOrThrow(EndpointClass cls, std::chrono::milliseconds maxWait) {
+    if (!acquire(cls, maxWait)) {
+        throw RateLimitException("Client-side rate limit reached; request not sent");
+    }
+}
+
+void AdaptiveRateLimiter::onResponse(EndpointClass cls, int statusCode,
+                                     const std::map<std::string, std::string>& headers) {
+    const auto retryAfter = headerSeconds(headers, "Retry-After");
+    if (statusCode == 429) {
+        onRateLimited(cls, std::chrono::milliseconds(static_cast<int64_t>(retryAfter.value_or(1.0) * 1000)));
+    } else if (statusCode == 503 && retryAfter) {
+        Bucket& bucket = buckets_[static_cast<size_t>(cls)];
+        std::lock_guard<std::mutex> lock(bucket.mutex);
+        bucket.blocked_until = std::max(bucket.blocked_until, Clock::now() + toDuration(*retryAfter));
+    }
+
+    const auto remaining = headerNumber(headers, "X-RateLimit-Remaining");
+    const auto reset = secondsUntilReset(headers);
+    if (!remaining || !reset) return;
+
+    Bucket& bucket = buckets_[static_cast<size_t>(cls)];
+    std::lock_guard<std::mutex> lock(bucket.mutex);
+    const Clock::time_point now = Clock::now();
+    refill(bucket, now);
+    if (*remaining < 1.0) {
+        // Quota spent: hold everything until the window resets.
+        bucket.blocked_until = std::max(bucket.blocked_until, now + toDuration(*reset));
+        bucket.tokens = std::min(bucket.tokens, 0.0);
+    } else if (*reset > 0) {
+        // Spread what is left evenly over the rest of the window.
+        bucket.rate = std::min(bucket.configured.requests_per_second, *remaining / *reset);
+        bucket.tokens = std::min(bucket.tokens, *remaining);
+    }
+    bucket.paced_until = now + toDuration(*reset);
+}
+
+void AdaptiveRateLimiter::onRateLimited(EndpointClass cls, std::chrono::milliseconds retryAfter) {
+    Bucket& bucket = buckets_[static_cast<size_t>(cls)];
+    std::lock_guard<std::mutex> lock(bucket.mutex);
+    const Clock::time_point now = Clock::now();
+    refill(bucket, now);
+    ++bucket.rate_limited;
+    bucket.blocked_until = std::max(bucket.blocked_until, now + retryAfter);
+    bucket.tokens = std::min(bucket.tokens, 0.0);
+    if (now >= bucket.paced_until) {
+        bucket.rate = std::max(bucket.rate * BACKOFF_FACTOR, bucket.configured.requests_per_second * MIN_RATE_SHARE);
+    }
+}
+
+RateLimiterStats AdaptiveRateLimiter::stats(EndpointClass cls) const {
+    const Bucket& bucket = buckets_[static_cast<size_t>(cls)];
+    std::lock_guard<std::mutex> lock(bucket.mutex);
+    RateLimiterStats s;
+    s.rate = bucket.rate;
+    s.tokens = bucket.tokens;
+    s.granted = bucket.granted;
+    s.delayed = bucket.delayed;
+    s.rejected = bucket.rejected;
+    s.rate_limited = bucket.rate_limited;
+    s.server_paced = Clock::now() < bucket.paced_until;
+    return s;
+}
+
+} // namespace LicenseChain
@@ -0,0 +1,141 @@
+#include "licensechain/replay_guard.h"
+#include <algorithm>
+#include <functional>
+
+namespace LicenseChain {
+
+namespace {
+
+constexpr uint64_t EMPTY = 0;
+constexpr uint64_t TOMBSTONE = 1;
+constexpr size_t NOT_FOUND = static_cast<size_t>(-1);
+
+size_t nextPowerOfTwo(size_t n) {
+    size_t p = 1;
+    while (p < n) p <<= 1;
+    return p;
+}
+
+} // namespace
+
+ReplayGuard::ReplayGuard(std::chrono::seconds window, size_t expectedEventsPerSecond, size_t buckets)
+    : window_(std::max(window, std::chrono::seconds(1))), origin_(Clock::now()) {
+    buckets = std::max<size_t>(buckets, 1);
+    bucket_span_ = std::chrono::duration_cast<Clock::duration>(window_) / static_cast<Clock::rep>(buckets);
+
+    // One spare slice: the oldest one still covers IDs inside the window
+    // while the current one fills.
+    const auto perBucket = static_cast<size_t>(
+        static_cast<double>(std::max<size_t>(expectedEventsPerSecond, 1)) * window_.count() / buckets + 1);
+    max_per_bucket_ = std::max<size_t>(perBucket, 16);
+    // Keep tables at most 3/4 full so probe sequences stay short.
+    const size_t slots = nextPowerOfTwo(max_per_bucket_ + max_per_bucket_ / 3 + 1);
+    slot_mask_ = slots - 1;
+
+    ring_.resize(buckets + 1);
+    for (auto& bucket : ring_) bucket.slots.assign(slots, EMPTY);
+}
+
+bool ReplayGuard::insert(std::string_view id) {
+    return insert(id, Clock::now());
+}
+
+bool ReplayGuard::insert(std::string_view id, Clock::time_point now) {
+    const uint64_t fp = fingerprint(id);
+    std::lock_guard<std::mutex> lock(mutex_);
+    advance(now);
+    if (containsLocked(fp)) return false;
+
+    Bucket& bucket = ring_[static_cast<size_t>(current_epoch_) % ring_.size()];
+    if (bucket.used >= max_per_bucket_) {
+        ++overflows_;
+        return true;
+    }
+    size_t i = fp & slot_mask_;
+    while (bucket.slots[i] != EMPTY) i = (i + 1) & slot_mask_;
+    bucket.slots[i] = fp;
+    ++bucket.used;
+    ++bucket.live;
+    return true;
+}
+
+bool ReplayGuard::contains(std::string_view id) const {
+    const uint64_t fp = fingerprint(id);
+    std::lock_guard<std::mutex> lock(mutex_);
+    return containsLocked(fp);
+}
+
+void ReplayGuard::erase(std::string_view id) {
+    const uint64_t fp = fingerprint(id);
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& bucket : ring_) {
+        const size_t slot = findSlot(bucket, fp);
+        if (slot != NOT_FOUND) {
+            bucket.slots[slot] = TOMBSTONE;
+            --bucket.live;
+            return;
+        }
+    }
+}
+
+void ReplayGuard::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& bucket : ring_) {
+        std::fill(bucket.slots.begin(), bucket.slots.end(), EMPTY);
+        bucket.used = bucket.live = 0;
+    }
+}
+
+size_t ReplayGuard::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t total = 0;
+    for (const auto& bucket : ring_) total += bucket.live;
+    return total;
+}
+
+uint64_t ReplayGuard::overflows() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return overflows_;
+}
+
+uint64_t ReplayGuard::fingerprint(std::string_view id) {
+    const uint64_t h = std::hash<std::string_view>{}(id);
+    // Mix so that the low bits used for the slot index depend on every byte
+    // even where std::hash is weak, and keep clear of the reserved values.
+    uint64_t x = h ^ (h >> 33);
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    return x > TOMBSTONE ? x : x + 2;
+}
+
+void ReplayGuard::advance(Clock::time_point now) {
+    const int64_t epoch = now <= origin_ ? 0 : static_cast<int64_t>((now - origin_) / bucket_span_);
+    if (epoch <= current_epoch_) return;
+
+    // Clear the slices that now fall out of the window, at most the whole ring.
+    const int64_t steps = std::min<int64_t>(epoch - current_epoch_, static_cast<int64_t>(ring_.size()));
+    for (int64_t e = epoch - steps + 1; e <= epoch; ++e) {
+        Bucket& bucket = ring_[static_cast<size_t>(e) % ring_.size()];
+        if (bucket.used > 0) std::fill(bucket.slots.begin(), bucket.slots.end(), EMPTY);
+        bucket.used = bucket.live = 0;
+    }
+    current_epoch_ = epoch;
+}
+
+size_t ReplayGuard::findSlot(const Bucket& bucket, uint64_t fp) const {
+    if (bucket.live == 0) return NOT_FOUND;
+    for (size_t i = fp & slot_mask_;; i = (i + 1) & slot_mask_) {
+        const uint64_t value = bucket.slots[i];
+        if (value == fp) return i;
+        if (value == EMPTY) return NOT_FOUND;
+    }
+}
+
+bool ReplayGuard::containsLocked(uint64_t fp) const {
+    for (const auto& bucket : ring_) {
+        if (findSlot(bucket, fp) != NOT_FOUND) return true;
+    }
+    return false;
+}
+
+} // namespace LicenseChain
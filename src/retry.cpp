@@ -0,0 +1,112 @@
+#include "licensechain/retry.h"
+#include "licensechain/exceptions.h"
+#include <algorithm>
+#include <random>
+
+namespace LicenseChain {
+
+// RetryPolicy
+
+std::chrono::milliseconds RetryPolicy::nextDelay(std::chrono::milliseconds previous) const {
+    // Jitter only spreads retries out, so a cheap per-thread generator will do.
+    thread_local std::minstd_rand generator(std::random_device{}());
+
+    const int64_t base = std::max<int64_t>(base_delay.count(), 1);
+    const int64_t upper = std::max(base, std::max<int64_t>(previous.count(), base) * 3);
+    std::uniform_int_distribution<int64_t> distribution(base, upper);
+    return std::chrono::milliseconds(std::min<int64_t>(distribution(generator), std::max(max_delay.count(), base)));
+}
+
+bool RetryPolicy::isRetryable(const std::exception_ptr& error) {
+    if (!error) return false;
+    try {
+        std::rethrow_exception(error);
+    } catch (const ValidationException&) {
+        return false;
+    } catch (const AuthenticationException&) {
+        return false;
+    } catch (const NotFoundException&) {
+        return false;
+    } catch (const ConfigurationException&) {
+        return false;
+    } catch (const CircuitOpenException&) {
+        return false;
+    } catch (const CancelledException&) {
+        return false;
+    } catch (const DeadlineExceededException&) {
+        return false;
+    } catch (const RateLimitException&) {
+        return true;
+    } catch (const NetworkException&) {
+        return true;
+    } catch (const ServerException&) {
+        return true;
+    } catch (const LicenseChainException& e) {
+        const int status = e.getStatusCode();
+        return status == 0 || status == 408 || status == 429 || status == 502 || status == 503 || status == 504;
+    } catch (...) {
+        return false;
+    }
+}
+
+// RetryBudget
+
+RetryBudget::RetryBudget(double ratio, double reserve)
+    : deposit_(static_cast<int64_t>(std::max(ratio, 0.0) * SCALE)),
+      capacity_(std::max<int64_t>(static_cast<int64_t>(std::max(reserve, 0.0) * SCALE), SCALE)),
+      balance_(capacity_) {}
+
+void RetryBudget::recordRequest() {
+    int64_t current = balance_.load(std::memory_order_relaxed);
+    while (current < capacity_ &&
+           !balance_.compare_exchange_weak(current, std::min(current + deposit_, capacity_), std::memory_order_relaxed)) {
+    }
+}
+
+bool RetryBudget::tryWithdraw() {
+    int64_t current = balance_.load(std::memory_order_relaxed);
+    while (current >= SCALE) {
+        if (balance_.compare_exchange_weak(current, current - SCALE, std::memory_order_relaxed)) return true;
+    }
+    return false;
+}
+
+double RetryBudget::balance() const {
+    return static_cast<double>(balance_.load(std::memory_order_relaxed)) / SCALE;
+}
+
+// RetryScheduler
+
+RetryScheduler::RetryScheduler(Executor& executor, TimerWheel& timers, RetryPolicy policy,
+                               std::shared_ptr<RetryBudget> budget)
+    : executor_(executor), timers_(timers), policy_(policy),
+      budget_(budget ? std::move(budget) : std::make_shared<RetryBudget>()) {}
+
+RetryStats RetryScheduler::stats() const {
+    RetryStats s;
+    s.calls = calls_.load(std::memory_order_relaxed);
+    s.retries = retries_.load(std::memory_order_relaxed);
+    s.not_retryable = not_retryable_.load(std::memory_order_relaxed);
+    s.budget_exhausted = budget_exhausted_.load(std::memory_order_relaxed);
+    s.attempts_exhausted = attempts_exhausted_.load(std::memory_order_relaxed);
+    return s;
+}
+
+bool RetryScheduler::shouldRetry(const std::exception_ptr& error, int attempt) {
+    if (!RetryPolicy::isRetryable(error)) {
+        not_retryable_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    if (attempt >= policy_.max_attempts) {
+        attempts_exhausted_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    if (!budget_->tryWithdraw()) {
+        budget_exhausted_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    retries_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+} // namespace LicenseChain
@@ -0,0 +1,47 @@
+#include "licensechain/services.h"
+#include "licensechain/session.h"
+
+namespace LicenseChain {
+
+namespace {
+
+std::shared_ptr<Session> requireSession(std::shared_ptr<Session> session) {
+    if (!session) throw ConfigurationException("Service requires a session");
+    return session;
+}
+
+} // namespace
+
+// LicenseService
+
+LicenseService::LicenseService(std::shared_ptr<Session> session) : session_(requireSession(std::move(session))) {}
+
+std::string LicenseService::makeRequest(const std::string& method, const std::string& endpoint, const std::string& body) {
+    return session_->send(method, endpoint, body).body;
+}
+
+// UserService
+
+UserService::UserService(std::shared_ptr<Session> session) : session_(requireSession(std::move(session))) {}
+
+std::string UserService::makeRequest(const std::string& method, const std::string& endpoint, const std::string& body) {
+    return session_->send(method, endpoint, body).body;
+}
+
+// ProductService
+
+ProductService::ProductService(std::shared_ptr<Session> session) : session_(requireSession(std::move(session))) {}
+
+std::string ProductService::makeRequest(const std::string& method, const std::string& endpoint, const std::string& body) {
+    return session_->send(method, endpoint, body).body;
+}
+
+// WebhookService
+
+WebhookService::WebhookService(std::shared_ptr<Session> session) : session_(requireSession(std::move(session))) {}
+
+std::string WebhookService::makeRequest(const std::string& method, const std::string& endpoint, const std::string& body) {
+    return session_->send(method, endpoint, body).body;
+}
+
+} // namespace LicenseChain
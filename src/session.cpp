@@ -0,0 +1,243 @@
+#include "licensechain/session.h"
+#include "licensechain/exceptions.h"
+#include <algorithm>
+
+namespace LicenseChain {
+
+namespace {
+
+std::shared_ptr<const HeaderBlock> buildHeaders(const SessionConfig& config) {
+    auto block = std::make_shared<HeaderBlock>();
+    block->fields = {
+        {"Content-Type", "application/json"},
+        {"Accept", "application/json"},
+        {"User-Agent", config.user_agent},
+    };
+    for (const auto& [name, value] : block->fields) {
+        block->serialized.append(name).append(": ").append(value).append("\r\n");
+    }
+    return block;
+}
+
+std::chrono::milliseconds boundedWait(std::chrono::milliseconds wait, const CancellationToken& token) {
+    const auto remaining = token.remaining();
+    if (remaining == CancellationToken::Clock::duration::max()) return wait;
+    return std::min(wait, std::chrono::duration_cast<std::chrono::milliseconds>(remaining));
+}
+
+} // namespace
+
+Session::Session(SessionConfig config, Transport transport)
+    : config_(std::move(config)),
+      transport_(std::move(transport)),
+      headers_(buildHeaders(config_)),
+      executor_(config_.threads, config_.max_queue_depth, config_.reserved_queue_depth, config_.reserved_threads),
+      timers_(),
+      retries_(executor_, timers_, config_.retry),
+      concurrency_(config_.concurrency),
+      breakers_(config_.circuit_breaker),
+      cache_(config_.cache_capacity, config_.cache_ttl, config_.cache_max_stale) {
+    if (!config_.api_key.empty()) {
+        default_tenant_.authorization = std::make_shared<const std::string>("Bearer " + config_.api_key);
+    }
+}
+
+Session::~Session() {
+    // Drain work first: running tasks may still arm timers, and timers post
+    // back into the executor, which refuses once it is shut down.
+    executor_.shutdown();
+    timers_.shutdown();
+}
+
+void Session::setTokenManager(std::shared_ptr<TokenManager> tokens) {
+    std::atomic_store(&tokens_, std::move(tokens));
+}
+
+Session::Credentials Session::credentials(const Tenant& tenant) const {
+    if (&tenant != &default_tenant_) return {std::atomic_load(&tenant.authorization), 0};
+    if (const auto tokens = std::atomic_load(&tokens_)) {
+        if (auto header = tokens->header()) {
+            // Aliasing constructor: shares ownership of the header, no copy.
+            return {std::shared_ptr<const std::string>(header, &header->value), header->generation};
+        }
+    }
+    return {default_tenant_.authorization, 0};
+}
+
+HttpResponse Session::exchange(const HttpRequest& request) const {
+    try {
+        return transport_(request);
+    } catch (const LicenseChainException&) {
+        throw;
+    } catch (const std::exception& e) {
+        throw NetworkException(e.what());
+    }
+}
+
+std::string Session::breakerKey(EndpointClass cls, const std::string& endpoint) {
+    size_t start = endpoint.empty() || endpoint[0] != '/' ? 0 : 1;
+    size_t end = endpoint.find_first_of("/?", start);
+    // Skip an API version like "v1"; every endpoint shares it.
+    const bool versioned = end != std::string::npos && endpoint[end] == '/' && end - start >= 2 &&
+                           endpoint[start] == 'v' &&
+                           std::all_of(endpoint.begin() + static_cast<std::ptrdiff_t>(start + 1),
+                                       endpoint.begin() + static_cast<std::ptrdiff_t>(end),
+                                       [](char c) { return c >= '0' && c <= '9'; });
+    if (versioned) {
+        start = end + 1;
+        end = endpoint.find_first_of("/?", start);
+    }
+    std::string key = std::to_string(static_cast<int>(cls));
+    key.append(":/").append(endpoint, start, end == std::string::npos ? std::string::npos : end - start);
+    return key;
+}
+
+void Session::throwForStatus(const HttpResponse& response) {
+    const int status = response.status;
+    if (status >= 200 && status < 300) return;
+    const std::string message = response.body.empty() ? "HTTP " + std::to_string(status) : response.body;
+    switch (status) {
+        case 400:
+        case 422:
+            throw ValidationException(message);
+        case 401:
+        case 403:
+            throw AuthenticationException(message);
+        case 404:
+            throw NotFoundException(message);
+        case 429:
+            throw RateLimitException(message);
+        default:
+            break;
+    }
+    if (status >= 500) throw ServerException(message);
+    throw LicenseChainException("HTTP_ERROR", message, status);
+}
+
+HttpResponse Session::send(const std::string& method, const std::string& endpoint, const std::string& body,
+                           const CancellationToken& token) {
+    return send(default_tenant_, method, endpoint, body, token);
+}
+
+HttpResponse Session::send(Tenant& tenant, const std::string& method, const std::string& endpoint,
+                           const std::string& body, const CancellationToken& token) {
+    if (!transport_) throw ConfigurationException("Session has no transport");
+    token.throwIfCancelled();
+    requests_.fetch_add(1, std::memory_order_relaxed);
+
+    const EndpointClass cls = classifyEndpoint(method, endpoint);
+    const RequestPriority priority = priorityOf(cls);
+    const auto wait = boundedWait(config_.max_queue_wait, token);
+    if (!tenant.rate_limiter.acquire(cls, wait)) {
+        throttled_.fetch_add(1, std::memory_order_relaxed);
+        throw RateLimitException("Client-side rate limit reached; request not sent");
+    }
+    auto permit = concurrency_.acquire(wait, priority);
+    if (!permit) {
+        throttled_.fetch_add(1, std::memory_order_relaxed);
+        throw LicenseChainException("CONCURRENCY_LIMIT", "Too many requests in flight; request not sent", 503);
+    }
+
+    CircuitBreaker& breaker = breakers_.forEndpoint(breakerKey(cls, endpoint));
+    HttpResponse response;
+    bool invoked = false;     // the transport was called
+    bool responded = false;   // and returned a response: a real round trip
+    try {
+        response = breaker.execute([&] {
+            HttpRequest request;
+            request.method = method;
+            request.url = config_.base_url + endpoint;
+            request.headers = headers_;
+            Credentials creds = credentials(tenant);
+            request.authorization = std::move(creds.authorization);
+            request.auth_generation = creds.generation;
+            request.body = body;
+            request.timeout = boundedWait(config_.timeout, token);
+            request.token = token;
+            request.endpoint_class = cls;
+            request.priority = priority;
+
+            invoked = true;
+            HttpResponse result = exchange(request);
+            responded = true;
+
+            // The token was rejected: refresh it, or pick up a refresh that
+            // already happened, and try once more. If the refresh fails or
+            // does not finish in time, the 401 stands.
+            const auto tokens = request.auth_generation != 0 ? std::atomic_load(&tokens_) : nullptr;
+            if (result.status == 401 && tokens) {
+                std::shared_ptr<const AuthHeader> fresh;
+                try {
+                    auto refreshed = tokens->refresh(request.auth_generation);
+                    if (refreshed.wait_for(boundedWait(config_.timeout, token)) == std::future_status::ready) {
+                        fresh = refreshed.get();
+                    }
+                } catch (const std::exception&) {
+                }
+                if (fresh && fresh->generation != request.auth_generation && !token.isCancelled()) {
+                    request.authorization = std::shared_ptr<const std::string>(fresh, &fresh->value);
+                    request.auth_generation = fresh->generation;
+                    request.timeout = boundedWait(config_.timeout, token);
+                    result = exchange(request);
+                }
+            }
+            tenant.rate_limiter.onResponse(cls, result.status, result.headers);
+            throwForStatus(result);
+            return result;
+        });
+    } catch (...) {
+        failures_.fetch_add(1, std::memory_order_relaxed);
+        // Only load-related failures shrink the concurrency limit, and only
+        // real round trips are RTT samples: a request refused by an open
+        // circuit or abandoned by its caller would drag the baseline down.
+        ConcurrencyLimiter::Outcome outcome = ConcurrencyLimiter::Outcome::Ignored;
+        if (invoked && !token.isCancelled()) {
+            if (CircuitBreaker::isFailure(std::current_exception())) {
+                outcome = ConcurrencyLimiter::Outcome::Dropped;
+            } else if (responded) {
+                outcome = ConcurrencyLimiter::Outcome::Success;
+            }
+        }
+        permit->release(outcome);
+        throw;
+    }
+    permit->release(ConcurrencyLimiter::Outcome::Success);
+    return response;
+}
+
+std::string Session::getCached(const std::string& endpoint, const CancellationToken& token) {
+    return getCached(default_tenant_, endpoint, token);
+}
+
+std::string Session::getCached(Tenant& tenant, const std::string& endpoint, const CancellationToken& token) {
+    // One cache for all tenants keeps memory bounded; the key prefix keeps
+    // their entries apart.
+    const std::string key = tenant.id.empty() ? endpoint : tenant.id + ' ' + endpoint;
+    if (auto cached = cache_.get(key)) {
+        cache_hits_.fetch_add(1, std::memory_order_relaxed);
+        return std::move(*cached);
+    }
+    try {
+        HttpResponse response = send(tenant, "GET", endpoint, "", token);
+        cache_.put(key, response.body);
+        return std::move(response.body);
+    } catch (const CircuitOpenException&) {
+        if (auto stale = cache_.getStale(key)) {
+            stale_hits_.fetch_add(1, std::memory_order_relaxed);
+            return std::move(*stale);
+        }
+        throw;
+    }
+}
+
+SessionMetrics Session::metrics() const {
+    SessionMetrics m;
+    m.requests = requests_.load(std::memory_order_relaxed);
+    m.failures = failures_.load(std::memory_order_relaxed);
+    m.cache_hits = cache_hits_.load(std::memory_order_relaxed);
+    m.stale_hits = stale_hits_.load(std::memory_order_relaxed);
+    m.throttled = throttled_.load(std::memory_order_relaxed);
+    return m;
+}
+
+} // namespace LicenseChain
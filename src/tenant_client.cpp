@@ -0,0 +1,82 @@
+#include "licensechain/tenant_client.h"
+#include "licensechain/exceptions.h"
+#include <mutex>
+
+namespace LicenseChain {
+
+TenantClient::TenantClient(SessionConfig config, Session::Transport transport) {
+    // The session's own key is only used for the shared JWKS fetch, which
+    // needs no credentials.
+    config.api_key.clear();
+    session_ = std::make_shared<Session>(std::move(config), std::move(transport));
+}
+
+void TenantClient::addTenant(const std::string& tenantId, const std::string& apiKey) {
+    if (tenantId.empty()) throw ConfigurationException("Tenant id must not be empty");
+    if (apiKey.empty()) throw ConfigurationException("Tenant " + tenantId + " has no API key");
+    auto authorization = std::make_shared<const std::string>("Bearer " + apiKey);
+
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    auto& slot = tenants_[tenantId];
+    if (slot) {
+        // Keep the learned rate-limit state; a new key has the same quota.
+        std::atomic_store(&slot->authorization, std::move(authorization));
+        return;
+    }
+    slot = std::make_shared<Tenant>();
+    slot->id = tenantId;
+    slot->authorization = std::move(authorization);
+}
+
+bool TenantClient::removeTenant(const std::string& tenantId) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    return tenants_.erase(tenantId) != 0;
+}
+
+bool TenantClient::hasTenant(const std::string& tenantId) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return tenants_.count(tenantId) != 0;
+}
+
+size_t TenantClient::tenantCount() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return tenants_.size();
+}
+
+std::vector<std::string> TenantClient::tenantIds() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    std::vector<std::string> ids;
+    ids.reserve(tenants_.size());
+    for (const auto& entry : tenants_) ids.push_back(entry.first);
+    return ids;
+}
+
+std::shared_ptr<Tenant> TenantClient::find(const std::string& tenantId) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    auto it = tenants_.find(tenantId);
+    if (it == tenants_.end()) throw NotFoundException("Unknown tenant " + tenantId);
+    return it->second;
+}
+
+HttpResponse TenantClient::send(const std::string& tenantId, const std::string& method, const std::string& endpoint,
+                                const std::string& body, const CancellationToken& token) {
+    // Holding the shared_ptr keeps the tenant alive if it is removed mid-request.
+    const auto tenant = find(tenantId);
+    return session_->send(*tenant, method, endpoint, body, token);
+}
+
+std::string TenantClient::getCached(const std::string& tenantId, const std::string& endpoint,
+                                    const CancellationToken& token) {
+    const auto tenant = find(tenantId);
+    return session_->getCached(*tenant, endpoint, token);
+}
+
+std::string TenantClient::jwks(const CancellationToken& token) {
+    return session_->getCached(JWKS_ENDPOINT, token);
+}
+
+RateLimiterStats TenantClient::rateLimiterStats(const std::string& tenantId, EndpointClass cls) const {
+    return find(tenantId)->rate_limiter.stats(cls);
+}
+
+} // namespace LicenseChain
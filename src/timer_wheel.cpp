@@ -0,0 +1,88 @@
+#include "licensechain/timer_wheel.h"
+#include <algorithm>
+
+namespace LicenseChain {
+
+TimerWheel::TimerWheel(std::chrono::milliseconds tick, size_t slots)
+    : tick_(std::max(tick, std::chrono::milliseconds(1))), slots_(std::max<size_t>(slots, 1)) {
+    thread_ = std::thread([this] { run(); });
+}
+
+TimerWheel::~TimerWheel() {
+    shutdown();
+}
+
+uint64_t TimerWheel::schedule(std::chrono::milliseconds delay, Task task) {
+    // At least one tick, so a timer never fires in the tick it was added.
+    const uint64_t ticks = std::max<uint64_t>(1, static_cast<uint64_t>((delay + tick_ - std::chrono::milliseconds(1)) / tick_));
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (stopping_) return 0;
+    const uint64_t id = next_id_++;
+    const size_t slot = (cursor_ + ticks) % slots_.size();
+    slots_[slot].push_back(Timer{id, (ticks - 1) / slots_.size(), std::move(task)});
+    live_.insert(id);
+    return id;
+}
+
+bool TimerWheel::cancel(uint64_t id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    // The entry stays in its slot and is skipped when reached.
+    return live_.erase(id) > 0;
+}
+
+void TimerWheel::shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stopping_) return;
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    if (thread_.joinable()) thread_.join();
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& slot : slots_) slot.clear();
+    live_.clear();
+}
+
+size_t TimerWheel::pending() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return live_.size();
+}
+
+void TimerWheel::run() {
+    auto next = std::chrono::steady_clock::now() + tick_;
+    std::vector<Task> due;
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!stopping_) {
+        if (wake_.wait_until(lock, next, [this] { return stopping_; })) break;
+        next += tick_;
+
+        cursor_ = (cursor_ + 1) % slots_.size();
+        auto& slot = slots_[cursor_];
+        size_t kept = 0;
+        for (auto& timer : slot) {
+            if (live_.count(timer.id) == 0) continue;
+            if (timer.rounds > 0) {
+                --timer.rounds;
+                if (&slot[kept] != &timer) slot[kept] = std::move(timer);
+                ++kept;
+            } else {
+                live_.erase(timer.id);
+                due.push_back(std::move(timer.task));
+            }
+        }
+        slot.resize(kept);
+
+        if (due.empty()) continue;
+        lock.unlock();
+        for (auto& task : due) {
+            try {
+                task();
+            } catch (...) {
+            }
+        }
+        due.clear();
+        lock.lock();
+    }
+}
+
+} // namespace LicenseChain
@@ -0,0 +1,168 @@
+#include "licensechain/token_manager.h"
+#include "licensechain/exceptions.h"
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+
+namespace LicenseChain {
+
+using HeaderPtr = std::shared_ptr<const AuthHeader>;
+
+struct TokenManager::State : std::enable_shared_from_this<TokenManager::State> {
+    State(Executor& e, TimerWheel& t, Refresher r, TokenRefreshOptions o)
+        : executor(e), timers(t), refresher(std::move(r)), options(o) {}
+
+    Executor& executor;
+    TimerWheel& timers;
+    const Refresher refresher;
+    const TokenRefreshOptions options;
+
+    HeaderPtr header;  // accessed only through std::atomic_load/atomic_store
+
+    // Guards everything below; taken on the refresh path, never by header().
+    std::mutex mutex;
+    std::string refresh_token;
+    std::shared_ptr<std::promise<HeaderPtr>> in_flight;
+    std::shared_future<HeaderPtr> in_flight_future;
+    uint64_t generation = 0;
+    uint64_t timer = 0;
+    std::chrono::milliseconds retry_delay{0};
+    bool stopped = false;
+
+    std::atomic<uint64_t> refreshes{0};
+    std::atomic<uint64_t> failures{0};
+    std::atomic<uint64_t> coalesced{0};
+
+    HeaderPtr publishLocked(const AuthToken& token);
+    void scheduleLocked(std::chrono::milliseconds delay);
+    std::shared_future<HeaderPtr> refresh(uint64_t staleGeneration);
+    void run(const std::shared_ptr<std::promise<HeaderPtr>>& promise);
+};
+
+HeaderPtr TokenManager::State::publishLocked(const AuthToken& token) {
+    const auto lifetime = std::max(std::chrono::duration_cast<std::chrono::milliseconds>(
+                                       token.expires_at - std::chrono::system_clock::now()),
+                                   std::chrono::milliseconds(0));
+    auto next = std::make_shared<AuthHeader>();
+    next->value = "Bearer " + token.access_token;
+    next->expires_at = std::chrono::steady_clock::now() + lifetime;
+    next->generation = ++generation;
+    HeaderPtr published = std::move(next);
+    std::atomic_store(&header, published);
+
+    if (!token.refresh_token.empty()) refresh_token = token.refresh_token;
+    retry_delay = std::chrono::milliseconds(0);
+
+    // Refresh at refresh_at of the lifetime, or min_margin before expiry if
+    // that comes first; very short lifetimes just use the share.
+    const auto byShare = std::chrono::milliseconds(static_cast<int64_t>(static_cast<double>(lifetime.count()) * options.refresh_at));
+    const auto byMargin = lifetime - options.min_margin;
+    scheduleLocked(byMargin.count() > 0 ? std::min(byShare, byMargin) : byShare);
+    return published;
+}
+
+void TokenManager::State::scheduleLocked(std::chrono::milliseconds delay) {
+    if (stopped) return;
+    if (timer != 0) timers.cancel(timer);
+    std::weak_ptr<State> weak = shared_from_this();
+    timer = timers.schedule(delay, [weak] {
+        if (auto self = weak.lock()) self->refresh(0);
+    });
+}
+
+std::shared_future<HeaderPtr> TokenManager::State::refresh(uint64_t staleGeneration) {
+    std::lock_guard<std::mutex> lock(mutex);
+    const HeaderPtr current = std::atomic_load(&header);
+    if (stopped || (staleGeneration != 0 && current && current->generation != staleGeneration)) {
+        coalesced.fetch_add(1, std::memory_order_relaxed);
+        std::promise<HeaderPtr> ready;
+        ready.set_value(current);
+        return ready.get_future().share();
+    }
+    if (in_flight) {
+        coalesced.fetch_add(1, std::memory_order_relaxed);
+        return in_flight_future;
+    }
+
+    auto promise = std::make_shared<std::promise<HeaderPtr>>();
+    auto future = promise->get_future().share();
+    if (!executor.tryPost([self = shared_from_this(), promise] { self->run(promise); })) {
+        promise->set_exception(std::make_exception_ptr(LicenseChainException("EXECUTOR_SHUTDOWN", "Executor rejected token refresh")));
+        return future;
+    }
+    in_flight = promise;
+    in_flight_future = future;
+    return future;
+}
+
+void TokenManager::State::run(const std::shared_ptr<std::promise<HeaderPtr>>& promise) {
+    std::string token;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        token = refresh_token;
+    }
+    try {
+        AuthToken next = refresher(token);
+        HeaderPtr published;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            published = publishLocked(next);
+            in_flight.reset();
+        }
+        refreshes.fetch_add(1, std::memory_order_relaxed);
+        promise->set_value(std::move(published));
+    } catch (...) {
+        failures.fetch_add(1, std::memory_order_relaxed);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            in_flight.reset();
+            // Keep serving the old header and try again after transient
+            // errors; a rejected refresh token needs a new login instead.
+            if (RetryPolicy::isRetryable(std::current_exception())) {
+                retry_delay = options.retry.nextDelay(retry_delay);
+                scheduleLocked(retry_delay);
+            }
+        }
+        promise->set_exception(std::current_exception());
+    }
+}
+
+// TokenManager
+
+TokenManager::TokenManager(Executor& executor, TimerWheel& timers, Refresher refresher, TokenRefreshOptions options)
+    : state_(std::make_shared<State>(executor, timers, std::move(refresher), options)) {
+    if (!state_->refresher) throw ConfigurationException("TokenManager requires a refresher");
+}
+
+TokenManager::~TokenManager() {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    state_->stopped = true;
+    if (state_->timer != 0) state_->timers.cancel(state_->timer);
+}
+
+void TokenManager::setToken(const AuthToken& token) {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    state_->publishLocked(token);
+}
+
+std::shared_ptr<const AuthHeader> TokenManager::header() const {
+    return std::atomic_load(&state_->header);
+}
+
+std::shared_future<std::shared_ptr<const AuthHeader>> TokenManager::refresh(uint64_t staleGeneration) {
+    return state_->refresh(staleGeneration);
+}
+
+TokenManagerStats TokenManager::stats() const {
+    TokenManagerStats s;
+    {
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        s.generation = state_->generation;
+    }
+    s.refreshes = state_->refreshes.load(std::memory_order_relaxed);
+    s.failures = state_->failures.load(std::memory_order_relaxed);
+    s.coalesced = state_->coalesced.load(std::memory_order_relaxed);
+    return s;
+}
+
+} // namespace LicenseChain
@@ -1,42 +1,143 @@
 #include "licensechain/utils.h"
 #include "licensechain/exceptions.h"
+#include "licensechain/webhook_verifier.h"
 #include <regex>
-#include <random>
 #include <sstream>
 #include <iomanip>
 #include <algorithm>
 #include <thread>
 #include <chrono>
+#include <cstdint>
+#include <cstring>
 #include <openssl/sha.h>
 #include <openssl/md5.h>
-#include <openssl/hmac.h>
 #include <openssl/evp.h>
-#include <openssl/bio.h>
-#include <openssl/buffer.h>
 #include <openssl/crypto.h>
+#include <openssl/rand.h>
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define LICENSECHAIN_X86_DISPATCH 1
+#include <tmmintrin.h>
+#endif
 
 namespace LicenseChain {
 
+namespace {
+
+inline bool isRegexSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r';
+}
+
+inline bool isKeyChar(char c) {
+    return static_cast<unsigned char>(c - 'A') < 26 || static_cast<unsigned char>(c - '0') < 10;
+}
+
+inline bool isLowerHex(char c) {
+    return static_cast<unsigned char>(c - '0') < 10 || static_cast<unsigned char>(c - 'a') < 6;
+}
+
+constexpr size_t LICENSE_KEY_LENGTH = 32;
+constexpr size_t UUID_LENGTH = 36;
+
+#if defined(__SSE2__) || defined(_M_X64)
+// Bitmask of bytes in [lo, lo + count), using the signed-compare range trick.
+inline int rangeMask(__m128i v, char lo, char count) {
+    const __m128i shifted = _mm_add_epi8(v, _mm_set1_epi8(static_cast<char>(-128 - lo)));
+    return _mm_movemask_epi8(_mm_cmplt_epi8(shifted, _mm_set1_epi8(static_cast<char>(-128 + count))));
+}
+
+inline bool licenseKeySimd(const char* p) {
+    const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 16));
+    const int ok = (rangeMask(a, 'A', 26) | rangeMask(a, '0', 10)) & (rangeMask(b, 'A', 26) | rangeMask(b, '0', 10));
+    return ok == 0xFFFF;
+}
+
+// Checks 16 bytes of a UUID: hex digits everywhere except the dash positions.
+inline bool uuidBlockSimd(const char* p, int dashes) {
+    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    const int dash = _mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8('-')));
+    const int hex = rangeMask(v, '0', 10) | rangeMask(v, 'a', 6);
+    return dash == dashes && (hex | dash) == 0xFFFF;
+}
+
+inline bool uuidSimd(const char* p) {
+    // Overlapping loads at 0, 16 and 20 cover all 36 bytes; dashes sit at 8, 13, 18 and 23.
+    return uuidBlockSimd(p, (1 << 8) | (1 << 13)) &&
+           uuidBlockSimd(p + 16, (1 << 2) | (1 << 7)) &&
+           uuidBlockSimd(p + 20, 1 << 3);
+}
+#endif
+
+inline bool licenseKeyShape(std::string_view key) {
+    if (key.size() != LICENSE_KEY_LENGTH) return false;
+#if defined(__SSE2__) || defined(_M_X64)
+    return licenseKeySimd(key.data());
+#else
+    return std::all_of(key.begin(), key.end(), isKeyChar);
+#endif
+}
+
+inline bool uuidShape(std::string_view uuid) {
+    if (uuid.size() != UUID_LENGTH) return false;
+#if defined(__SSE2__) || defined(_M_X64)
+    return uuidSimd(uuid.data());
+#else
+    for (size_t i = 0; i < UUID_LENGTH; ++i) {
+        const bool dashPosition = i == 8 || i == 13 || i == 18 || i == 23;
+        if (dashPosition ? uuid[i] != '-' : !isLowerHex(uuid[i])) return false;
+    }
+    return true;
+#endif
+}
+
+} // namespace
+
 // Validation functions
-bool Utils::validateEmail(const std::string& email) {
-    if (email.empty()) return false;
+bool Utils::validateEmail(std::string_view email) {
+    // Equivalent to ^[^\s@]+@[^\s@]+\.[^\s@]+$
+    const size_t at = email.find('@');
+    if (at == 0 || at == std::string_view::npos) return false;
     
-    std::regex emailRegex(R"(^[^\s@]+@[^\s@]+\.[^\s@]+$)");
-    return std::regex_match(email, emailRegex);
+    bool domainDot = false;
+    for (size_t i = 0; i < email.size(); ++i) {
+        const char c = email[i];
+        if (isRegexSpace(c) || (c == '@' && i != at)) return false;
+        if (c == '.' && i > at + 1 && i + 1 < email.size()) domainDot = true;
+    }
+    return domainDot;
 }
 
-bool Utils::validateLicenseKey(const std::string& licenseKey) {
-    if (licenseKey.empty() || licenseKey.length() != 32) return false;
-    
-    std::regex keyRegex(R"(^[A-Z0-9]+$)");
-    return std::regex_match(licenseKey, keyRegex);
+bool Utils::validateLicenseKey(std::string_view licenseKey) {
+    return licenseKeyShape(licenseKey);
 }
 
-bool Utils::validateUuid(const std::string& uuid) {
-    if (uuid.empty()) return false;
-    
-    std::regex uuidRegex(R"(^[0-9a-f]{8}-[0-9a-f]{4}-[0-9a-f]{4}-[0-9a-f]{4}-[0-9a-f]{12}$)");
-    return std::regex_match(uuid, uuidRegex);
+bool Utils::validateUuid(std::string_view uuid) {
+    return uuidShape(uuid);
+}
+
+std::vector<bool> Utils::validateLicenseKeys(const std::vector<std::string_view>& licenseKeys) {
+    std::vector<bool> result(licenseKeys.size());
+    for (size_t i = 0; i < licenseKeys.size(); ++i) {
+        result[i] = licenseKeyShape(licenseKeys[i]);
+    }
+    return result;
+}
+
+std::vector<bool> Utils::validateUuids(const std::vector<std::string_view>& uuids) {
+    std::vector<bool> result(uuids.size());
+    for (size_t i = 0; i < uuids.size(); ++i) {
+        result[i] = uuidShape(uuids[i]);
+    }
+    return result;
 }
 
 bool Utils::validateAmount(double amount) {
@@ -71,47 +172,154 @@ std::map<std::string, std::string> Utils::sanitizeMetadata(const std::map<std::s
 }
 
 // Generation functions
-std::string Utils::generateLicenseKey() {
-    const std::string chars = "ABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789";
-    auto& rng = getRandomGenerator();
-    std::uniform_int_distribution<> dist(0, chars.size() - 1);
+namespace {
+
+constexpr char LICENSE_KEY_CHARS[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789";
+constexpr unsigned LICENSE_KEY_ALPHABET = 36;
+
+// Per-thread buffer of CSPRNG output, refilled from RAND_bytes. Threads never
+// share state, so generation is race-free without locking, and each refill
+// amortises one RAND_bytes call over a few thousand draws.
+class RandomStream {
+public:
+    uint8_t next() {
+        if (pos_ == sizeof(buffer_)) refill();
+        return buffer_[pos_++];
+    }
     
-    std::string result;
-    for (int i = 0; i < 32; ++i) {
-        result += chars[dist(rng)];
+    void fill(uint8_t* out, size_t length) {
+        while (length > 0) {
+            if (pos_ == sizeof(buffer_)) {
+                if (length >= sizeof(buffer_)) {
+                    // Large requests bypass the buffer; RAND_bytes takes an int length.
+                    const size_t n = std::min<size_t>(length, INT32_MAX);
+                    if (RAND_bytes(out, static_cast<int>(n)) != 1) fail();
+                    out += n;
+                    length -= n;
+                    continue;
+                }
+                refill();
+            }
+            const size_t n = std::min(length, sizeof(buffer_) - pos_);
+            std::memcpy(out, buffer_ + pos_, n);
+            pos_ += n;
+            out += n;
+            length -= n;
+        }
     }
+    
+    // Uniform index in [0, bound) for bound <= 256, by rejection sampling.
+    unsigned uniformByte(unsigned bound) {
+        const unsigned limit = 256 - 256 % bound;
+        for (;;) {
+            const unsigned value = next();
+            if (value < limit) return value % bound;
+        }
+    }
+    
+    // Drops buffered bytes inherited across fork() so parent and child never
+    // hand out the same output.
+    void checkOwner() {
+#ifndef _WIN32
+        const pid_t pid = getpid();
+        if (pid != owner_) {
+            owner_ = pid;
+            pos_ = sizeof(buffer_);
+        }
+#endif
+    }
+
+private:
+    void refill() {
+        if (RAND_bytes(buffer_, sizeof(buffer_)) != 1) fail();
+        pos_ = 0;
+    }
+    
+    [[noreturn]] static void fail() {
+        throw LicenseChainException("RANDOM_ERROR", "RAND_bytes failed to produce random data");
+    }
+    
+    uint8_t buffer_[4096];
+    size_t pos_ = sizeof(buffer_);
+#ifndef _WIN32
+    pid_t owner_ = 0;
+#endif
+};
+
+RandomStream& randomStream() {
+    thread_local RandomStream stream;
+    stream.checkOwner();
+    return stream;
+}
+
+void writeLicenseKey(RandomStream& rng, char* out) {
+    for (size_t i = 0; i < LICENSE_KEY_LENGTH; ++i) {
+        out[i] = LICENSE_KEY_CHARS[rng.uniformByte(LICENSE_KEY_ALPHABET)];
+    }
+}
+
+// Random (version 4, RFC 4122 variant) UUID in canonical lowercase form.
+void writeUuid(RandomStream& rng, char* out) {
+    uint8_t bytes[16];
+    rng.fill(bytes, sizeof(bytes));
+    bytes[6] = static_cast<uint8_t>((bytes[6] & 0x0F) | 0x40);
+    bytes[8] = static_cast<uint8_t>((bytes[8] & 0x3F) | 0x80);
+    
+    Utils::toHex(bytes, 4, out);
+    out[8] = '-';
+    Utils::toHex(bytes + 4, 2, out + 9);
+    out[13] = '-';
+    Utils::toHex(bytes + 6, 2, out + 14);
+    out[18] = '-';
+    Utils::toHex(bytes + 8, 2, out + 19);
+    out[23] = '-';
+    Utils::toHex(bytes + 10, 6, out + 24);
+}
+
+} // namespace
+
+std::string Utils::generateLicenseKey() {
+    std::string result(LICENSE_KEY_LENGTH, '\0');
+    writeLicenseKey(randomStream(), &result[0]);
     return result;
 }
 
 std::string Utils::generateUuid() {
-    auto& rng = getRandomGenerator();
-    std::uniform_int_distribution<> dist(0, 15);
-    std::uniform_int_distribution<> dist2(8, 11);
-    
-    std::stringstream ss;
-    int i;
-    ss << std::hex;
-    for (i = 0; i < 8; i++) {
-        ss << dist(rng);
-    }
-    ss << "-";
-    for (i = 0; i < 4; i++) {
-        ss << dist(rng);
+    std::string result(UUID_LENGTH, '\0');
+    writeUuid(randomStream(), &result[0]);
+    return result;
+}
+
+std::vector<std::string> Utils::generateLicenseKeys(size_t count) {
+    auto& rng = randomStream();
+    std::vector<std::string> result(count, std::string(LICENSE_KEY_LENGTH, '\0'));
+    for (auto& key : result) {
+        writeLicenseKey(rng, &key[0]);
     }
-    ss << "-4";
-    for (i = 0; i < 3; i++) {
-        ss << dist(rng);
+    return result;
+}
+
+std::vector<std::string> Utils::generateUuids(size_t count) {
+    auto& rng = randomStream();
+    std::vector<std::string> result(count, std::string(UUID_LENGTH, '\0'));
+    for (auto& uuid : result) {
+        writeUuid(rng, &uuid[0]);
     }
-    ss << "-";
-    ss << dist2(rng);
-    for (i = 0; i < 3; i++) {
-        ss << dist(rng);
+    return result;
+}
+
+void Utils::generateLicenseKeys(size_t count, char* out) {
+    auto& rng = randomStream();
+    for (size_t i = 0; i < count; ++i, out += LICENSE_KEY_LENGTH) {
+        writeLicenseKey(rng, out);
     }
-    ss << "-";
-    for (i = 0; i < 12; i++) {
-        ss << dist(rng);
+}
+
+void Utils::generateUuids(size_t count, char* out) {
+    auto& rng = randomStream();
+    for (size_t i = 0; i < count; ++i, out += UUID_LENGTH) {
+        writeUuid(rng, out);
     }
-    return ss.str();
 }
 
 // String utilities
@@ -162,18 +370,18 @@ std::string Utils::truncateString(const std::string& text, size_t maxLength) {
 }
 
 std::string Utils::slugify(const std::string& text) {
-    if (text.empty()) return text;
-    
-    std::string result = text;
-    std::transform(result.begin(), result.end(), result.begin(), ::tolower);
-    std::replace(result.begin(), result.end(), ' ', '-');
-    std::replace(result.begin(), result.end(), '_', '-');
-    
-    // Remove multiple consecutive dashes
-    result = std::regex_replace(result, std::regex("-+"), "-");
+    std::string result;
+    result.reserve(text.size());
     
-    // Remove leading/trailing dashes
-    if (!result.empty() && result[0] == '-') result = result.substr(1);
+    // Lowercase, map spaces/underscores to dashes, collapse dash runs and
+    // drop leading/trailing dashes in a single pass.
+    for (char c : text) {
+        if (c == ' ' || c == '_' || c == '-') {
+            if (!result.empty() && result.back() != '-') result += '-';
+        } else {
+            result += static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        }
+    }
     if (!result.empty() && result.back() == '-') result.pop_back();
     
     return result;
@@ -227,23 +435,176 @@ std::string Utils::formatPrice(double price, const std::string& currency) {
     return ss.str();
 }
 
+namespace {
+
+// Days since 1970-01-01 for a proleptic Gregorian date (H. Hinnant's algorithm).
+constexpr int64_t daysFromCivil(int64_t y, unsigned m, unsigned d) {
+    y -= m <= 2;
+    const int64_t era = (y >= 0 ? y : y - 399) / 400;
+    const unsigned yoe = static_cast<unsigned>(y - era * 400);
+    const unsigned doy = (153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + d - 1;
+    const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + static_cast<int64_t>(doe) - 719468;
+}
+
+constexpr void civilFromDays(int64_t z, int64_t& y, unsigned& m, unsigned& d) {
+    z += 719468;
+    const int64_t era = (z >= 0 ? z : z - 146096) / 146097;
+    const unsigned doe = static_cast<unsigned>(z - era * 146097);
+    const unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    const unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    const unsigned mp = (5 * doy + 2) / 153;
+    d = doy - (153 * mp + 2) / 5 + 1;
+    m = mp < 10 ? mp + 3 : mp - 9;
+    y = static_cast<int64_t>(yoe) + era * 400 + (m <= 2);
+}
+
+constexpr unsigned daysInMonth(int64_t y, unsigned m) {
+    constexpr unsigned days[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    if (m != 2) return days[m - 1];
+    return (y % 4 == 0 && (y % 100 != 0 || y % 400 == 0)) ? 29 : 28;
+}
+
+// Reads exactly `count` decimal digits starting at `pos`.
+inline bool readDigits(std::string_view s, size_t pos, size_t count, unsigned& value) {
+    if (pos + count > s.size()) return false;
+    value = 0;
+    for (size_t i = 0; i < count; ++i) {
+        const unsigned digit = static_cast<unsigned char>(s[pos + i]) - '0';
+        if (digit > 9) return false;
+        value = value * 10 + digit;
+    }
+    return true;
+}
+
+inline void writeDigits(char* out, unsigned value, int count) {
+    for (int i = count - 1; i >= 0; --i) {
+        out[i] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    }
+}
+
+} // namespace
+
 std::string Utils::formatTimestamp(const std::chrono::system_clock::time_point& timestamp) {
-    auto time_t = std::chrono::system_clock::to_time_t(timestamp);
-    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(timestamp.time_since_epoch()) % 1000;
+    char buffer[TIMESTAMP_BUFFER_SIZE];
+    auto result = formatTimestamp(buffer, buffer + sizeof(buffer), timestamp);
+    return std::string(buffer, result.ptr);
+}
+
+std::to_chars_result Utils::formatTimestamp(char* first, char* last,
+                                            const std::chrono::system_clock::time_point& timestamp) {
+    using namespace std::chrono;
+    if (last - first < static_cast<std::ptrdiff_t>(TIMESTAMP_BUFFER_SIZE)) {
+        return {last, std::errc::value_too_large};
+    }
     
-    std::stringstream ss;
-    ss << std::put_time(std::gmtime(&time_t), "%Y-%m-%dT%H:%M:%S");
-    ss << "." << std::setfill('0') << std::setw(3) << ms.count() << "Z";
-    return ss.str();
+    const int64_t ms = duration_cast<milliseconds>(timestamp.time_since_epoch()).count();
+    int64_t days = ms / 86400000;
+    int64_t msOfDay = ms % 86400000;
+    if (msOfDay < 0) {
+        msOfDay += 86400000;
+        --days;
+    }
+    
+    int64_t year;
+    unsigned month, day;
+    civilFromDays(days, year, month, day);
+    if (year < 0 || year > 9999) {
+        return {first, std::errc::value_too_large};
+    }
+    
+    const unsigned secondsOfDay = static_cast<unsigned>(msOfDay / 1000);
+    writeDigits(first, static_cast<unsigned>(year), 4);
+    first[4] = '-';
+    writeDigits(first + 5, month, 2);
+    first[7] = '-';
+    writeDigits(first + 8, day, 2);
+    first[10] = 'T';
+    writeDigits(first + 11, secondsOfDay / 3600, 2);
+    first[13] = ':';
+    writeDigits(first + 14, secondsOfDay / 60 % 60, 2);
+    first[16] = ':';
+    writeDigits(first + 17, secondsOfDay % 60, 2);
+    first[19] = '.';
+    writeDigits(first + 20, static_cast<unsigned>(msOfDay % 1000), 3);
+    first[23] = 'Z';
+    return {first + TIMESTAMP_BUFFER_SIZE, std::errc()};
 }
 
-std::chrono::system_clock::time_point Utils::parseTimestamp(const std::string& timestamp) {
-    std::tm tm = {};
-    std::stringstream ss(timestamp);
-    ss >> std::get_time(&tm, "%Y-%m-%dT%H:%M:%S");
+std::chrono::system_clock::time_point Utils::parseTimestamp(std::string_view timestamp) {
+    std::chrono::system_clock::time_point result;
+    if (!tryParseTimestamp(timestamp, result)) {
+        throw ValidationException("Invalid timestamp: " + std::string(timestamp));
+    }
+    return result;
+}
+
+bool Utils::tryParseTimestamp(std::string_view s, std::chrono::system_clock::time_point& result) {
+    using namespace std::chrono;
+    unsigned year, month, day;
+    if (!readDigits(s, 0, 4, year) || s.size() < 10 || s[4] != '-' || s[7] != '-' ||
+        !readDigits(s, 5, 2, month) || !readDigits(s, 8, 2, day)) {
+        return false;
+    }
+    if (month < 1 || month > 12 || day < 1 || day > daysInMonth(year, month)) return false;
+    
+    int64_t seconds = daysFromCivil(year, month, day) * 86400;
+    int64_t nanos = 0;
+    size_t pos = 10;
+    
+    if (pos < s.size()) {
+        const char sep = s[pos];
+        if (sep != 'T' && sep != 't' && sep != ' ') return false;
+        
+        unsigned hour, minute, second;
+        if (!readDigits(s, pos + 1, 2, hour) || s.size() < pos + 9 || s[pos + 3] != ':' ||
+            !readDigits(s, pos + 4, 2, minute) || s[pos + 6] != ':' || !readDigits(s, pos + 7, 2, second)) {
+            return false;
+        }
+        // RFC 3339 allows a leap second; it folds into the following second.
+        if (hour > 23 || minute > 59 || second > 60) return false;
+        seconds += hour * 3600 + minute * 60 + second;
+        pos += 9;
+        
+        if (pos < s.size() && (s[pos] == '.' || s[pos] == ',')) {
+            size_t digits = 0;
+            int64_t scale = 100000000;
+            for (++pos; pos < s.size(); ++pos, ++digits) {
+                const unsigned digit = static_cast<unsigned char>(s[pos]) - '0';
+                if (digit > 9) break;
+                nanos += digit * scale;
+                scale /= 10;
+            }
+            if (digits == 0) return false;
+        }
+        
+        if (pos < s.size()) {
+            const char zone = s[pos];
+            if (zone == 'Z' || zone == 'z') {
+                ++pos;
+            } else if (zone == '+' || zone == '-') {
+                unsigned offsetHours, offsetMinutes = 0;
+                if (!readDigits(s, pos + 1, 2, offsetHours)) return false;
+                pos += 3;
+                if (pos < s.size()) {
+                    if (s[pos] == ':') ++pos;
+                    if (!readDigits(s, pos, 2, offsetMinutes)) return false;
+                    pos += 2;
+                }
+                if (offsetHours > 23 || offsetMinutes > 59) return false;
+                const int64_t offset = offsetHours * 3600 + offsetMinutes * 60;
+                seconds -= zone == '+' ? offset : -offset;
+            } else {
+                return false;
+            }
+        }
+    }
+    if (pos != s.size()) return false;
     
-    auto time_t = std::mktime(&tm);
-    return std::chrono::system_clock::from_time_t(time_t);
+    result = system_clock::time_point(duration_cast<system_clock::duration>(
+        std::chrono::seconds(seconds) + std::chrono::nanoseconds(nanos)));
+    return true;
 }
 
 // Validation helpers
@@ -282,82 +643,366 @@ void Utils::validateDateRange(const std::chrono::system_clock::time_point& start
 
 // Crypto functions
 std::string Utils::createWebhookSignature(const std::string& payload, const std::string& secret) {
-    unsigned char* result;
-    unsigned int len = 32;
-    
-    result = HMAC(EVP_sha256(), secret.c_str(), secret.length(),
-                  reinterpret_cast<const unsigned char*>(payload.c_str()), payload.length(),
-                  nullptr, &len);
-    
-    return toHex(std::vector<uint8_t>(result, result + len));
+    return WebhookVerifier(secret).sign(payload);
 }
 
 bool Utils::verifyWebhookSignature(const std::string& payload, const std::string& signature, const std::string& secret) {
     if (payload.empty() || signature.empty() || secret.empty()) return false;
-    std::string expected = createWebhookSignature(payload, secret);
-    const std::string received = (signature.size() >= 7 && signature.compare(0, 7, "sha256=") == 0)
-        ? signature.substr(7) : signature;
-    if (expected.size() != received.size()) return false;
-    return CRYPTO_memcmp(expected.data(), received.data(), expected.size()) == 0;
+    return WebhookVerifier(secret).verify(payload, signature);
+}
+
+std::vector<bool> Utils::verifyWebhookSignatures(const std::vector<std::pair<std::string_view, std::string_view>>& items,
+                                                 const std::string& secret) {
+    if (secret.empty()) return std::vector<bool>(items.size(), false);
+    return WebhookVerifier(secret).verifyBatch(items);
 }
 
 std::string Utils::sha256(const std::string& data) {
     unsigned char hash[SHA256_DIGEST_LENGTH];
     SHA256(reinterpret_cast<const unsigned char*>(data.c_str()), data.length(), hash);
-    return toHex(std::vector<uint8_t>(hash, hash + SHA256_DIGEST_LENGTH));
+    std::string hex(SHA256_DIGEST_LENGTH * 2, '\0');
+    toHex(hash, SHA256_DIGEST_LENGTH, &hex[0]);
+    return hex;
 }
 
 std::string Utils::sha1(const std::string& data) {
     unsigned char hash[SHA_DIGEST_LENGTH];
     SHA1(reinterpret_cast<const unsigned char*>(data.c_str()), data.length(), hash);
-    return toHex(std::vector<uint8_t>(hash, hash + SHA_DIGEST_LENGTH));
+    std::string hex(SHA_DIGEST_LENGTH * 2, '\0');
+    toHex(hash, SHA_DIGEST_LENGTH, &hex[0]);
+    return hex;
 }
 
 std::string Utils::md5(const std::string& data) {
     unsigned char hash[MD5_DIGEST_LENGTH];
     MD5(reinterpret_cast<const unsigned char*>(data.c_str()), data.length(), hash);
-    return toHex(std::vector<uint8_t>(hash, hash + MD5_DIGEST_LENGTH));
+    std::string hex(MD5_DIGEST_LENGTH * 2, '\0');
+    toHex(hash, MD5_DIGEST_LENGTH, &hex[0]);
+    return hex;
 }
 
 // Encoding/Decoding
-std::string Utils::base64Encode(const std::string& data) {
-    BIO* bio, *b64;
-    BUF_MEM* bufferPtr;
+namespace {
+
+constexpr char BASE64_ALPHABET[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+constexpr char BASE64URL_ALPHABET[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+constexpr char HEX_DIGITS[] = "0123456789abcdef";
+constexpr uint8_t INVALID_SEXTET = 0xFF;
+
+struct DecodeTable {
+    uint8_t values[256];
+};
+
+constexpr DecodeTable makeDecodeTable(const char* alphabet) {
+    DecodeTable table{};
+    for (int i = 0; i < 256; ++i) table.values[i] = INVALID_SEXTET;
+    for (int i = 0; i < 64; ++i) table.values[static_cast<unsigned char>(alphabet[i])] = static_cast<uint8_t>(i);
+    return table;
+}
+
+constexpr DecodeTable BASE64_DECODE = makeDecodeTable(BASE64_ALPHABET);
+constexpr DecodeTable BASE64URL_DECODE = makeDecodeTable(BASE64URL_ALPHABET);
+
+constexpr DecodeTable makeHexTable() {
+    DecodeTable table{};
+    for (int i = 0; i < 256; ++i) table.values[i] = INVALID_SEXTET;
+    for (int i = 0; i < 10; ++i) table.values['0' + i] = static_cast<uint8_t>(i);
+    for (int i = 0; i < 6; ++i) {
+        table.values['a' + i] = static_cast<uint8_t>(10 + i);
+        table.values['A' + i] = static_cast<uint8_t>(10 + i);
+    }
+    return table;
+}
+
+constexpr DecodeTable HEX_DECODE = makeHexTable();
+
+#ifdef LICENSECHAIN_X86_DISPATCH
+bool cpuHasSsse3() {
+    static const bool supported = __builtin_cpu_supports("ssse3");
+    return supported;
+}
+
+// Base64 kernels after W. Mula and D. Lemire, "Faster Base64 Encoding and
+// Decoding Using AVX2 Instructions" (128-bit variants).
+// Encodes 12 input bytes (16 readable) into 16 characters.
+__attribute__((target("ssse3")))
+inline __m128i base64EncodeBlock(__m128i in, bool url) {
+    in = _mm_shuffle_epi8(in, _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+    const __m128i t0 = _mm_and_si128(in, _mm_set1_epi32(0x0fc0fc00));
+    const __m128i t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+    const __m128i t2 = _mm_and_si128(in, _mm_set1_epi32(0x003f03f0));
+    const __m128i t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+    const __m128i indices = _mm_or_si128(t1, t3);
     
-    b64 = BIO_new(BIO_f_base64());
-    bio = BIO_new(BIO_s_mem());
-    bio = BIO_push(b64, bio);
+    // Map each sextet to the offset that turns it into its ASCII character.
+    __m128i reduced = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+    const __m128i less = _mm_cmpgt_epi8(_mm_set1_epi8(26), indices);
+    reduced = _mm_or_si128(reduced, _mm_and_si128(less, _mm_set1_epi8(13)));
+    const __m128i offsets = _mm_setr_epi8(
+        'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+        '0' - 52, '0' - 52, '0' - 52, static_cast<char>((url ? '-' : '+') - 62),
+        static_cast<char>((url ? '_' : '/') - 63), 'A', 0, 0);
+    return _mm_add_epi8(_mm_shuffle_epi8(offsets, reduced), indices);
+}
+
+__attribute__((target("ssse3")))
+size_t base64EncodeSsse3(const uint8_t* data, size_t length, char* out, bool url) {
+    size_t i = 0;
+    char* o = out;
+    for (; i + 16 <= length; i += 12, o += 16) {
+        const __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(o), base64EncodeBlock(in, url));
+    }
+    return i;
+}
+
+// Returns a mask of bytes in [lo, lo + count) (SSE2 signed-compare trick).
+inline __m128i byteRange(__m128i v, char lo, char count) {
+    const __m128i shifted = _mm_add_epi8(v, _mm_set1_epi8(static_cast<char>(-128 - lo)));
+    return _mm_cmplt_epi8(shifted, _mm_set1_epi8(static_cast<char>(-128 + count)));
+}
+
+// Decodes 16 characters into 12 bytes (16 written). Returns false on any
+// character outside the alphabet.
+__attribute__((target("ssse3")))
+inline bool base64DecodeBlock(__m128i in, bool url, uint8_t* out) {
+    const __m128i upper = byteRange(in, 'A', 26);
+    const __m128i lower = byteRange(in, 'a', 26);
+    const __m128i digit = byteRange(in, '0', 10);
+    const __m128i c62 = _mm_cmpeq_epi8(in, _mm_set1_epi8(url ? '-' : '+'));
+    const __m128i c63 = _mm_cmpeq_epi8(in, _mm_set1_epi8(url ? '_' : '/'));
+    const __m128i valid = _mm_or_si128(_mm_or_si128(upper, lower), _mm_or_si128(digit, _mm_or_si128(c62, c63)));
+    if (_mm_movemask_epi8(valid) != 0xFFFF) return false;
     
-    BIO_set_flags(bio, BIO_FLAGS_BASE64_NO_NL);
-    BIO_write(bio, data.c_str(), data.length());
-    BIO_flush(bio);
+    __m128i shift = _mm_and_si128(upper, _mm_set1_epi8(-'A'));
+    shift = _mm_or_si128(shift, _mm_and_si128(lower, _mm_set1_epi8(26 - 'a')));
+    shift = _mm_or_si128(shift, _mm_and_si128(digit, _mm_set1_epi8(52 - '0')));
+    shift = _mm_or_si128(shift, _mm_and_si128(c62, _mm_set1_epi8(static_cast<char>(62 - (url ? '-' : '+')))));
+    shift = _mm_or_si128(shift, _mm_and_si128(c63, _mm_set1_epi8(static_cast<char>(63 - (url ? '_' : '/')))));
+    const __m128i sextets = _mm_add_epi8(in, shift);
     
-    BIO_get_mem_ptr(bio, &bufferPtr);
-    std::string result(bufferPtr->data, bufferPtr->length);
+    const __m128i pairs = _mm_maddubs_epi16(sextets, _mm_set1_epi32(0x01400140));
+    const __m128i words = _mm_madd_epi16(pairs, _mm_set1_epi32(0x00011000));
+    const __m128i packed = _mm_shuffle_epi8(words, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), packed);
+    return true;
+}
+
+// Decodes whole 16-character blocks while the output stays in bounds;
+// returns the number of characters consumed, or npos on invalid input.
+__attribute__((target("ssse3")))
+size_t base64DecodeSsse3(const char* data, size_t length, uint8_t* out, bool url) {
+    size_t i = 0;
+    for (; i + 24 <= length; i += 16, out += 12) {
+        const __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        if (!base64DecodeBlock(in, url, out)) return std::string_view::npos;
+    }
+    return i;
+}
+
+__attribute__((target("ssse3")))
+size_t hexEncodeSsse3(const uint8_t* data, size_t length, char* out) {
+    const __m128i digits = _mm_loadu_si128(reinterpret_cast<const __m128i*>(HEX_DIGITS));
+    const __m128i nibble = _mm_set1_epi8(0x0f);
+    size_t i = 0;
+    for (; i + 16 <= length; i += 16, out += 32) {
+        const __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        const __m128i hi = _mm_shuffle_epi8(digits, _mm_and_si128(_mm_srli_epi16(in, 4), nibble));
+        const __m128i lo = _mm_shuffle_epi8(digits, _mm_and_si128(in, nibble));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_unpacklo_epi8(hi, lo));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 16), _mm_unpackhi_epi8(hi, lo));
+    }
+    return i;
+}
+
+__attribute__((target("ssse3")))
+inline bool hexDecodeBlock(__m128i in, __m128i& values) {
+    const __m128i digit = byteRange(in, '0', 10);
+    const __m128i lower = byteRange(in, 'a', 6);
+    const __m128i upper = byteRange(in, 'A', 6);
+    if (_mm_movemask_epi8(_mm_or_si128(digit, _mm_or_si128(lower, upper))) != 0xFFFF) return false;
+    __m128i shift = _mm_and_si128(digit, _mm_set1_epi8(-'0'));
+    shift = _mm_or_si128(shift, _mm_and_si128(lower, _mm_set1_epi8(10 - 'a')));
+    shift = _mm_or_si128(shift, _mm_and_si128(upper, _mm_set1_epi8(10 - 'A')));
+    // Combine (high, low) nibble pairs into one byte per 16-bit lane.
+    values = _mm_maddubs_epi16(_mm_add_epi8(in, shift), _mm_set1_epi16(0x0110));
+    return true;
+}
+
+// Returns the number of hex characters consumed, or npos on invalid input.
+__attribute__((target("ssse3")))
+size_t hexDecodeSsse3(const char* hex, size_t length, uint8_t* out) {
+    size_t i = 0;
+    for (; i + 32 <= length; i += 32, out += 16) {
+        __m128i a, b;
+        if (!hexDecodeBlock(_mm_loadu_si128(reinterpret_cast<const __m128i*>(hex + i)), a) ||
+            !hexDecodeBlock(_mm_loadu_si128(reinterpret_cast<const __m128i*>(hex + i + 16)), b)) {
+            return std::string_view::npos;
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_packus_epi16(a, b));
+    }
+    return i;
+}
+#endif
+
+size_t encodeBase64(const uint8_t* data, size_t length, char* out, const char* alphabet, bool url, bool padding) {
+    size_t i = 0;
+    char* o = out;
+#ifdef LICENSECHAIN_X86_DISPATCH
+    if (cpuHasSsse3()) {
+        i = base64EncodeSsse3(data, length, out, url);
+        o += i / 3 * 4;
+    }
+#else
+    (void)url;
+#endif
+    for (; i + 3 <= length; i += 3) {
+        const uint32_t v = (uint32_t(data[i]) << 16) | (uint32_t(data[i + 1]) << 8) | data[i + 2];
+        *o++ = alphabet[v >> 18];
+        *o++ = alphabet[(v >> 12) & 0x3F];
+        *o++ = alphabet[(v >> 6) & 0x3F];
+        *o++ = alphabet[v & 0x3F];
+    }
+    const size_t rest = length - i;
+    if (rest > 0) {
+        const uint32_t v = (uint32_t(data[i]) << 16) | (rest == 2 ? uint32_t(data[i + 1]) << 8 : 0);
+        *o++ = alphabet[v >> 18];
+        *o++ = alphabet[(v >> 12) & 0x3F];
+        if (rest == 2) *o++ = alphabet[(v >> 6) & 0x3F];
+        if (padding) {
+            if (rest == 1) *o++ = '=';
+            *o++ = '=';
+        }
+    }
+    return static_cast<size_t>(o - out);
+}
+
+bool decodeBase64(std::string_view data, uint8_t* out, size_t& outLength, const DecodeTable& table, bool url) {
+    size_t length = data.size();
+    if (length > 0 && data[length - 1] == '=') {
+        if (length % 4 != 0) return false;
+        --length;
+        if (data[length - 1] == '=') --length;
+    }
+    if (length % 4 == 1) return false;
     
-    BIO_free_all(bio);
+    size_t i = 0;
+    uint8_t* o = out;
+#ifdef LICENSECHAIN_X86_DISPATCH
+    if (cpuHasSsse3()) {
+        i = base64DecodeSsse3(data.data(), length, out, url);
+        if (i == std::string_view::npos) return false;
+        o += i / 4 * 3;
+    }
+#else
+    (void)url;
+#endif
+    const auto* in = reinterpret_cast<const unsigned char*>(data.data());
+    for (; i + 4 <= length; i += 4) {
+        const uint8_t a = table.values[in[i]], b = table.values[in[i + 1]];
+        const uint8_t c = table.values[in[i + 2]], d = table.values[in[i + 3]];
+        if ((a | b | c | d) & 0x80) return false;
+        const uint32_t v = (uint32_t(a) << 18) | (uint32_t(b) << 12) | (uint32_t(c) << 6) | d;
+        *o++ = static_cast<uint8_t>(v >> 16);
+        *o++ = static_cast<uint8_t>(v >> 8);
+        *o++ = static_cast<uint8_t>(v);
+    }
+    const size_t rest = length - i;
+    if (rest >= 2) {
+        const uint8_t a = table.values[in[i]], b = table.values[in[i + 1]];
+        const uint8_t c = rest == 3 ? table.values[in[i + 2]] : 0;
+        if ((a | b | c) & 0x80) return false;
+        const uint32_t v = (uint32_t(a) << 18) | (uint32_t(b) << 12) | (uint32_t(c) << 6);
+        *o++ = static_cast<uint8_t>(v >> 16);
+        if (rest == 3) *o++ = static_cast<uint8_t>(v >> 8);
+    }
+    outLength = static_cast<size_t>(o - out);
+    return true;
+}
+
+} // namespace
+
+size_t Utils::base64EncodedLength(size_t length, bool padding) {
+    return padding ? (length + 2) / 3 * 4 : length / 3 * 4 + (length % 3 == 0 ? 0 : length % 3 + 1);
+}
+
+size_t Utils::base64DecodedMaxLength(size_t length) {
+    return length / 4 * 3 + (length % 4 == 0 ? 0 : 2);
+}
+
+size_t Utils::base64Encode(const uint8_t* data, size_t length, char* out) {
+    return encodeBase64(data, length, out, BASE64_ALPHABET, false, true);
+}
+
+size_t Utils::base64UrlEncode(const uint8_t* data, size_t length, char* out) {
+    return encodeBase64(data, length, out, BASE64URL_ALPHABET, true, false);
+}
+
+bool Utils::base64Decode(std::string_view data, uint8_t* out, size_t& outLength) {
+    return decodeBase64(data, out, outLength, BASE64_DECODE, false);
+}
+
+bool Utils::base64UrlDecode(std::string_view data, uint8_t* out, size_t& outLength) {
+    return decodeBase64(data, out, outLength, BASE64URL_DECODE, true);
+}
+
+std::string Utils::base64Encode(const std::string& data) {
+    std::string result(base64EncodedLength(data.size()), '\0');
+    base64Encode(reinterpret_cast<const uint8_t*>(data.data()), data.size(), &result[0]);
     return result;
 }
 
 std::string Utils::base64Decode(const std::string& data) {
-    BIO* bio, *b64;
-    
-    int decodeLen = (data.length() * 3) / 4;
-    char* buffer = new char[decodeLen + 1];
-    
-    bio = BIO_new_mem_buf(data.c_str(), data.length());
-    b64 = BIO_new(BIO_f_base64());
-    bio = BIO_push(b64, bio);
-    
-    BIO_set_flags(bio, BIO_FLAGS_BASE64_NO_NL);
-    int length = BIO_read(bio, buffer, data.length());
-    BIO_free_all(bio);
-    
-    std::string result(buffer, length);
-    delete[] buffer;
+    std::string result(base64DecodedMaxLength(data.size()), '\0');
+    size_t length = 0;
+    if (!base64Decode(data, reinterpret_cast<uint8_t*>(&result[0]), length)) return std::string();
+    result.resize(length);
     return result;
 }
 
+std::string Utils::base64UrlEncode(const std::string& data) {
+    std::string result(base64EncodedLength(data.size(), false), '\0');
+    base64UrlEncode(reinterpret_cast<const uint8_t*>(data.data()), data.size(), &result[0]);
+    return result;
+}
+
+std::string Utils::base64UrlDecode(const std::string& data) {
+    std::string result(base64DecodedMaxLength(data.size()), '\0');
+    size_t length = 0;
+    if (!base64UrlDecode(data, reinterpret_cast<uint8_t*>(&result[0]), length)) return std::string();
+    result.resize(length);
+    return result;
+}
+
+void Utils::toHex(const uint8_t* data, size_t length, char* out) {
+    size_t i = 0;
+#ifdef LICENSECHAIN_X86_DISPATCH
+    if (cpuHasSsse3()) i = hexEncodeSsse3(data, length, out);
+#endif
+    for (; i < length; ++i) {
+        out[2 * i] = HEX_DIGITS[data[i] >> 4];
+        out[2 * i + 1] = HEX_DIGITS[data[i] & 0x0F];
+    }
+}
+
+bool Utils::fromHex(std::string_view hex, uint8_t* out) {
+    if (hex.size() % 2 != 0) return false;
+    size_t i = 0;
+#ifdef LICENSECHAIN_X86_DISPATCH
+    if (cpuHasSsse3()) {
+        i = hexDecodeSsse3(hex.data(), hex.size(), out);
+        if (i == std::string_view::npos) return false;
+    }
+#endif
+    const auto* in = reinterpret_cast<const unsigned char*>(hex.data());
+    for (; i < hex.size(); i += 2) {
+        const uint8_t hi = HEX_DECODE.values[in[i]], lo = HEX_DECODE.values[in[i + 1]];
+        if ((hi | lo) & 0x80) return false;
+        out[i / 2] = static_cast<uint8_t>((hi << 4) | lo);
+    }
+    return true;
+}
+
 std::string Utils::urlEncode(const std::string& data) {
     std::stringstream ss;
     for (char c : data) {
@@ -452,9 +1097,20 @@ std::map<std::string, std::string> Utils::jsonDeserialize(const std::string& jso
 }
 
 // URL utilities
-bool Utils::isValidUrl(const std::string& urlString) {
-    std::regex urlRegex(R"(^https?://[^\s/$.?#].[^\s]*$)");
-    return std::regex_match(urlString, urlRegex);
+bool Utils::isValidUrl(std::string_view urlString) {
+    // Equivalent to ^https?://[^\s/$.?#].[^\s]*$
+    std::string_view rest;
+    if (urlString.substr(0, 7) == "http://") rest = urlString.substr(7);
+    else if (urlString.substr(0, 8) == "https://") rest = urlString.substr(8);
+    else return false;
+    
+    if (rest.size() < 2) return false;
+    const char first = rest[0];
+    if (isRegexSpace(first) || first == '/' || first == '$' || first == '.' || first == '?' || first == '#') {
+        return false;
+    }
+    if (rest[1] == '\n' || rest[1] == '\r') return false;
+    return std::none_of(rest.begin() + 2, rest.end(), isRegexSpace);
 }
 
 // Time utilities
@@ -503,53 +1159,54 @@ std::map<std::string, std::string> Utils::unflattenObject(const std::map<std::st
 
 // Random generation
 std::string Utils::generateRandomString(size_t length, const std::string& characters) {
-    auto& rng = getRandomGenerator();
-    std::uniform_int_distribution<> dist(0, characters.size() - 1);
+    if (characters.empty()) return std::string();
     
-    std::string result;
-    for (size_t i = 0; i < length; ++i) {
-        result += characters[dist(rng)];
+    auto& rng = randomStream();
+    std::string result(length, '\0');
+    if (characters.size() <= 256) {
+        const unsigned bound = static_cast<unsigned>(characters.size());
+        for (auto& c : result) c = characters[rng.uniformByte(bound)];
+        return result;
+    }
+    
+    const uint32_t bound = static_cast<uint32_t>(characters.size());
+    const uint32_t limit = UINT32_MAX - UINT32_MAX % bound;
+    for (auto& c : result) {
+        uint32_t value;
+        do {
+            rng.fill(reinterpret_cast<uint8_t*>(&value), sizeof(value));
+        } while (value >= limit);
+        c = characters[value % bound];
     }
     return result;
 }
 
 std::vector<uint8_t> Utils::generateRandomBytes(size_t length) {
     std::vector<uint8_t> result(length);
-    auto& rng = getRandomGenerator();
-    std::uniform_int_distribution<uint8_t> dist(0, 255);
-    
-    for (size_t i = 0; i < length; ++i) {
-        result[i] = dist(rng);
-    }
+    generateRandomBytes(result.data(), length);
     return result;
 }
 
+void Utils::generateRandomBytes(uint8_t* out, size_t length) {
+    randomStream().fill(out, length);
+}
+
 // Sleep utility
 void Utils::sleep(int milliseconds) {
     std::this_thread::sleep_for(std::chrono::milliseconds(milliseconds));
 }
 
 // Private helper functions
-std::mt19937& Utils::getRandomGenerator() {
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    return gen;
-}
-
 std::string Utils::toHex(const std::vector<uint8_t>& data) {
-    std::stringstream ss;
-    for (uint8_t byte : data) {
-        ss << std::hex << std::setw(2) << std::setfill('0') << static_cast<int>(byte);
-    }
-    return ss.str();
+    std::string result(data.size() * 2, '\0');
+    toHex(data.data(), data.size(), &result[0]);
+    return result;
 }
 
 std::vector<uint8_t> Utils::fromHex(const std::string& hex) {
-    std::vector<uint8_t> result;
-    for (size_t i = 0; i < hex.length(); i += 2) {
-        std::string byteString = hex.substr(i, 2);
-        uint8_t byte = static_cast<uint8_t>(std::stoi(byteString, nullptr, 16));
-        result.push_back(byte);
+    std::vector<uint8_t> result(hex.size() / 2);
+    if (!fromHex(hex, result.data())) {
+        throw ValidationException("Invalid hex string");
     }
     return result;
 }
@@ -0,0 +1,660 @@
+#include "licensechain/webhook_handler.h"
+#include "licensechain/utils.h"
+#include <algorithm>
+#include <charconv>
+#include <cstdlib>
+#include <optional>
+
+namespace LicenseChain {
+
+namespace {
+
+// Minimal JSON scanner used to slice a webhook payload in one pass. It checks
+// structure (balanced containers, terminated strings) but does not decode
+// escapes or validate number and literal syntax.
+class PayloadScanner {
+public:
+    explicit PayloadScanner(std::string_view text) : p_(text.data()), end_(text.data() + text.size()) {}
+    
+    bool atEnd() {
+        skipSpace();
+        return p_ == end_;
+    }
+    
+    bool consume(char expected) {
+        skipSpace();
+        if (p_ == end_ || *p_ != expected) return false;
+        ++p_;
+        return true;
+    }
+    
+    // Raw string including its quotes.
+    bool string(std::string_view& raw) {
+        skipSpace();
+        if (p_ == end_ || *p_ != '"') return false;
+        const char* start = p_++;
+        while (p_ != end_) {
+            const char c = *p_++;
+            if (c == '"') {
+                raw = std::string_view(start, static_cast<size_t>(p_ - start));
+                return true;
+            }
+            if (c == '\\') {
+                if (p_ == end_) return false;
+                ++p_;
+            }
+        }
+        return false;
+    }
+    
+    // Raw text of any JSON value.
+    bool value(std::string_view& raw) {
+        skipSpace();
+        if (p_ == end_) return false;
+        const char first = *p_;
+        if (first == '"') return string(raw);
+        
+        const char* start = p_;
+        if (first == '{' || first == '[') {
+            int depth = 0;
+            while (p_ != end_) {
+                const char c = *p_;
+                if (c == '"') {
+                    std::string_view ignored;
+                    if (!string(ignored)) return false;
+                    continue;
+                }
+                ++p_;
+                if (c == '{' || c == '[') {
+                    ++depth;
+                } else if (c == '}' || c == ']') {
+                    if (--depth == 0) {
+                        raw = std::string_view(start, static_cast<size_t>(p_ - start));
+                        return true;
+                    }
+                }
+            }
+            return false;
+        }
+        
+        while (p_ != end_ && *p_ != ',' && *p_ != '}' && *p_ != ']' && !isSpace(*p_)) ++p_;
+        raw = std::string_view(start, static_cast<size_t>(p_ - start));
+        return !raw.empty();
+    }
+
+private:
+    static bool isSpace(char c) { return c == ' ' || c == '\t' || c == '\n' || c == '\r'; }
+    
+    void skipSpace() {
+        while (p_ != end_ && isSpace(*p_)) ++p_;
+    }
+    
+    const char* p_;
+    const char* end_;
+};
+
+// Built-in event types, in dispatch-table order.
+constexpr std::string_view KNOWN_EVENT_TYPES[] = {
+    "license.created", "license.updated", "license.revoked", "user.created", "user.updated",
+    "product.created", "product.updated", "webhook.created", "webhook.updated", "webhook.deleted",
+};
+constexpr size_t KNOWN_EVENT_COUNT = sizeof(KNOWN_EVENT_TYPES) / sizeof(KNOWN_EVENT_TYPES[0]);
+
+// Every built-in name is "<entity>.<7-letter verb>", so the first character
+// and the first letter of the verb are enough to tell them apart.
+constexpr unsigned eventTypeSlot(std::string_view type) {
+    return (static_cast<unsigned char>(type[0]) * 11u + static_cast<unsigned char>(type[type.size() - 7])) & 15u;
+}
+
+struct PerfectHashTable {
+    int8_t ids[16];
+    bool collisionFree;
+};
+
+constexpr PerfectHashTable buildPerfectHashTable() {
+    PerfectHashTable table{};
+    table.collisionFree = true;
+    for (auto& id : table.ids) id = -1;
+    for (size_t i = 0; i < KNOWN_EVENT_COUNT; ++i) {
+        auto& slot = table.ids[eventTypeSlot(KNOWN_EVENT_TYPES[i])];
+        if (slot >= 0) table.collisionFree = false;
+        slot = static_cast<int8_t>(i);
+    }
+    return table;
+}
+
+// Default shedding order of the built-in types, in dispatch-table order.
+constexpr EventPriority KNOWN_EVENT_PRIORITIES[] = {
+    EventPriority::High, EventPriority::High, EventPriority::Critical, EventPriority::Normal, EventPriority::Normal,
+    EventPriority::Normal, EventPriority::Normal, EventPriority::Low, EventPriority::Low, EventPriority::Low,
+};
+static_assert(sizeof(KNOWN_EVENT_PRIORITIES) / sizeof(KNOWN_EVENT_PRIORITIES[0]) == KNOWN_EVENT_COUNT,
+              "every built-in event type needs a default priority");
+
+// Pressure from which each priority below Critical is shed.
+constexpr double SHED_THRESHOLDS[] = {0.5, 0.75, 0.9};
+
+constexpr PerfectHashTable KNOWN_EVENT_HASH = buildPerfectHashTable();
+static_assert(KNOWN_EVENT_HASH.collisionFree, "built-in event type hash has a collision");
+
+// Dispatch ID of a built-in event type, or -1: one hash and one compare.
+int knownEventId(std::string_view type) {
+    if (type.size() < 8) return -1;
+    const int id = KNOWN_EVENT_HASH.ids[eventTypeSlot(type)];
+    return id >= 0 && KNOWN_EVENT_TYPES[id] == type ? id : -1;
+}
+
+std::string_view unquote(std::string_view raw) {
+    return raw.size() >= 2 && raw.front() == '"' ? raw.substr(1, raw.size() - 2) : raw;
+}
+
+// Event time from an RFC 3339 string or a number of Unix seconds.
+bool parseEventTime(std::string_view raw, std::chrono::system_clock::time_point& result) {
+    if (!raw.empty() && raw.front() == '"') return Utils::tryParseTimestamp(unquote(raw), result);
+    int64_t seconds = 0;
+    auto parsed = std::from_chars(raw.data(), raw.data() + raw.size(), seconds);
+    if (parsed.ec != std::errc() || parsed.ptr != raw.data() + raw.size()) return false;
+    result = std::chrono::system_clock::time_point(std::chrono::seconds(seconds));
+    return true;
+}
+
+// Top-level string or number member of a JSON object, unquoted; empty if absent.
+std::string_view findMember(std::string_view object, std::string_view name) {
+    PayloadScanner scanner(object);
+    if (!scanner.consume('{') || scanner.consume('}')) return {};
+    do {
+        std::string_view key, value;
+        if (!scanner.string(key) || !scanner.consume(':') || !scanner.value(value)) return {};
+        if (unquote(key) == name && value.front() != '{' && value.front() != '[') return unquote(value);
+    } while (scanner.consume(','));
+    return {};
+}
+
+} // namespace
+
+WebhookHandler::WebhookHandler(const std::string& secret) : tolerance_seconds_(300) {
+    setSecret(secret);
+    registerDefaultCallbacks();
+}
+
+WebhookHandler::~WebhookHandler() {
+    disableAsyncDispatch();
+}
+
+// Event registration
+void WebhookHandler::onEvent(const std::string& eventType, EventCallback callback) {
+    event_callbacks_[registerEventType(eventType)].owning.push_back(std::move(callback));
+}
+
+void WebhookHandler::onEventView(const std::string& eventType, EventViewCallback callback) {
+    event_callbacks_[registerEventType(eventType)].views.push_back(std::move(callback));
+}
+
+void WebhookHandler::onLicenseCreated(EventCallback callback) { onEvent("license.created", std::move(callback)); }
+void WebhookHandler::onLicenseUpdated(EventCallback callback) { onEvent("license.updated", std::move(callback)); }
+void WebhookHandler::onLicenseRevoked(EventCallback callback) { onEvent("license.revoked", std::move(callback)); }
+void WebhookHandler::onUserCreated(EventCallback callback) { onEvent("user.created", std::move(callback)); }
+void WebhookHandler::onUserUpdated(EventCallback callback) { onEvent("user.updated", std::move(callback)); }
+void WebhookHandler::onProductCreated(EventCallback callback) { onEvent("product.created", std::move(callback)); }
+void WebhookHandler::onProductUpdated(EventCallback callback) { onEvent("product.updated", std::move(callback)); }
+void WebhookHandler::onWebhookCreated(EventCallback callback) { onEvent("webhook.created", std::move(callback)); }
+void WebhookHandler::onWebhookUpdated(EventCallback callback) { onEvent("webhook.updated", std::move(callback)); }
+void WebhookHandler::onWebhookDeleted(EventCallback callback) { onEvent("webhook.deleted", std::move(callback)); }
+
+// Webhook processing
+bool WebhookHandler::processWebhook(std::string_view payload, std::string_view signature, std::string_view timestamp) {
+    return receiveWebhook(payload, signature, timestamp) == WebhookResult::Accepted;
+}
+
+WebhookResult WebhookHandler::receiveWebhook(std::string_view payload, std::string_view signature, std::string_view timestamp) {
+    if (!verifyTimestamp(timestamp, tolerance_seconds_)) return WebhookResult::InvalidTimestamp;
+    if (matchSecret(payload, signature) < 0) return WebhookResult::InvalidSignature;
+    
+    WebhookEventView view;
+    if (!parseWebhookEventView(payload, view)) return WebhookResult::InvalidPayload;
+    view.signature = signature;
+    
+    // Only the payload timestamp is covered by the signature; a replayer can
+    // send any header. The replay guard also forgets IDs after twice the
+    // tolerance, so older events must be refused by age.
+    std::string_view signedTime = findMember(payload, "timestamp");
+    if (signedTime.empty()) signedTime = findMember(payload, "created_at");
+    if (!verifyTimestamp(signedTime, tolerance_seconds_)) return WebhookResult::InvalidTimestamp;
+    
+    if (const auto shedding = std::atomic_load(&shedding_options_)) {
+        const EventPriority priority = getEventPriority(view.type);
+        if (!admit(priority, *shedding)) {
+            shed_counts_[static_cast<size_t>(priority)].fetch_add(1, std::memory_order_relaxed);
+            return WebhookResult::Shed;
+        }
+    }
+    
+    const auto guard = std::atomic_load(&replay_guard_);
+    const bool tracked = guard && !view.id.empty();
+    if (tracked && !guard->insert(view.id)) return WebhookResult::Duplicate;
+    
+    // If the event is not accepted, forget its ID so the sender's retry gets through.
+    const auto inbox = std::atomic_load(&inbox_);
+    uint64_t entry = 0;
+    try {
+        if (inbox) entry = inbox->append(payload, signature);
+        if (dispatch(view, nullptr, inbox, entry)) return WebhookResult::Accepted;
+    } catch (...) {
+        if (tracked) guard->erase(view.id);
+        throw;
+    }
+    if (inbox) inbox->acknowledge(entry);
+    if (tracked) guard->erase(view.id);
+    return WebhookResult::Rejected;
+}
+
+WebhookEvent WebhookHandler::parseWebhookEvent(const std::string& payload) {
+    WebhookEventView view;
+    if (!parseWebhookEventView(payload, view)) {
+        throw ValidationException("Webhook payload is not a JSON object");
+    }
+    return view.toEvent();
+}
+
+bool WebhookHandler::parseWebhookEventView(std::string_view payload, WebhookEventView& view) {
+    view = WebhookEventView{};
+    view.timestamp = Utils::getCurrentTimestamp();
+    
+    PayloadScanner scanner(payload);
+    if (!scanner.consume('{')) return false;
+    
+    std::string_view timestamp, createdAt;
+    if (!scanner.consume('}')) {
+        do {
+            std::string_view key, value;
+            if (!scanner.string(key) || !scanner.consume(':') || !scanner.value(value)) return false;
+            key = unquote(key);
+            if (key == "id") view.id = unquote(value);
+            else if (key == "type") view.type = unquote(value);
+            else if (key == "data") view.data = value;
+            else if (key == "timestamp") timestamp = value;
+            else if (key == "created_at") createdAt = value;
+        } while (scanner.consume(','));
+        if (!scanner.consume('}')) return false;
+    }
+    if (!scanner.atEnd()) return false;
+    
+    if (!parseEventTime(timestamp, view.timestamp)) parseEventTime(createdAt, view.timestamp);
+    return true;
+}
+
+// Signature verification
+bool WebhookHandler::verifySignature(const std::string& payload, const std::string& signature, const std::string& timestamp) {
+    if (!verifyTimestamp(timestamp, tolerance_seconds_)) return false;
+    return matchSecret(payload, signature) >= 0;
+}
+
+int WebhookHandler::matchSecret(std::string_view payload, std::string_view signature) const {
+    const auto ring = keyring();
+    return WebhookVerifier::findMatch(ring->verifiers, payload, signature);
+}
+
+std::vector<bool> WebhookHandler::verifySignatures(const std::vector<WebhookVerifier::SignedPayload>& items,
+                                                  size_t threads) const {
+    const auto ring = keyring();
+    return WebhookVerifier::verifyBatch(ring->verifiers, items.data(), items.size(), threads);
+}
+
+// Event handling
+bool WebhookHandler::handleEvent(const WebhookEvent& event) {
+    const WebhookEventView view{event.id, event.type, event.data, event.timestamp, event.signature};
+    return dispatch(view, &event);
+}
+
+bool WebhookHandler::handleEvent(const WebhookEventView& event) {
+    return dispatch(event, nullptr);
+}
+
+// Async dispatch
+void WebhookHandler::enableAsyncDispatch(size_t workers, size_t maxQueueDepth, bool blockWhenFull) {
+    disableAsyncDispatch();
+    block_when_full_ = blockWhenFull;
+    std::atomic_store(&dispatcher_, std::make_shared<Executor>(workers, maxQueueDepth));
+}
+
+void WebhookHandler::disableAsyncDispatch() {
+    if (auto dispatcher = std::atomic_exchange(&dispatcher_, std::shared_ptr<Executor>())) {
+        dispatcher->shutdown();
+    }
+}
+
+bool WebhookHandler::isAsyncDispatchEnabled() const {
+    return std::atomic_load(&dispatcher_) != nullptr;
+}
+
+ExecutorMetrics WebhookHandler::getDispatchMetrics() const {
+    const auto dispatcher = std::atomic_load(&dispatcher_);
+    return dispatcher ? dispatcher->metrics() : ExecutorMetrics{};
+}
+
+// Replay protection
+void WebhookHandler::enableReplayProtection(size_t expectedEventsPerSecond) {
+    replay_events_per_second_ = expectedEventsPerSecond;
+    const auto window = std::chrono::seconds(2 * static_cast<int64_t>(std::max(tolerance_seconds_, 1)));
+    std::atomic_store(&replay_guard_, std::make_shared<ReplayGuard>(window, expectedEventsPerSecond));
+}
+
+void WebhookHandler::disableReplayProtection() {
+    std::atomic_store(&replay_guard_, std::shared_ptr<ReplayGuard>());
+}
+
+bool WebhookHandler::isReplayProtectionEnabled() const {
+    return std::atomic_load(&replay_guard_) != nullptr;
+}
+
+// Load shedding
+void WebhookHandler::enableLoadShedding(const LoadSheddingOptions& options) {
+    auto published = std::make_shared<LoadSheddingOptions>(options);
+    if (published->max_in_flight == 0) published->max_in_flight = 1;
+    if (published->target_latency.count() <= 0) published->target_latency = std::chrono::milliseconds(1);
+    std::atomic_store(&shedding_options_, std::shared_ptr<const LoadSheddingOptions>(std::move(published)));
+}
+
+void WebhookHandler::disableLoadShedding() {
+    std::atomic_store(&shedding_options_, std::shared_ptr<const LoadSheddingOptions>());
+}
+
+void WebhookHandler::setEventPriority(const std::string& eventType, EventPriority priority) {
+    event_callbacks_[registerEventType(eventType)].priority = priority;
+}
+
+EventPriority WebhookHandler::getEventPriority(std::string_view eventType) const {
+    const Callbacks* callbacks = findCallbacks(eventType);
+    return callbacks ? callbacks->priority : EventPriority::Normal;
+}
+
+LoadSheddingMetrics WebhookHandler::getLoadSheddingMetrics() const {
+    LoadSheddingMetrics metrics;
+    metrics.in_flight = in_flight_.load(std::memory_order_relaxed);
+    metrics.latency = std::chrono::nanoseconds(latency_ns_.load(std::memory_order_relaxed));
+    const auto shedding = std::atomic_load(&shedding_options_);
+    metrics.pressure = shedding ? loadPressure(*shedding) : 0.0;
+    for (size_t i = 0; i < 4; ++i) metrics.shed[i] = shed_counts_[i].load(std::memory_order_relaxed);
+    return metrics;
+}
+
+// Durable inbox
+void WebhookHandler::setInbox(std::shared_ptr<WebhookInbox> inbox) {
+    std::atomic_store(&inbox_, std::move(inbox));
+}
+
+std::shared_ptr<WebhookInbox> WebhookHandler::getInbox() const {
+    return std::atomic_load(&inbox_);
+}
+
+void WebhookHandler::setMaxReplayAttempts(uint32_t maxReplayAttempts) {
+    max_replay_attempts_ = std::max<uint32_t>(maxReplayAttempts, 1);
+}
+
+void WebhookHandler::onDeadLetter(DeadLetterCallback callback) {
+    dead_letter_callback_ = std::move(callback);
+}
+
+void WebhookHandler::deadLetter(WebhookInbox& inbox, const WebhookInbox::Entry& entry) {
+    if (dead_letter_callback_) {
+        try {
+            dead_letter_callback_(entry);
+        } catch (...) {
+        }
+    }
+    inbox.acknowledge(entry.sequence);
+}
+
+size_t WebhookHandler::replayInbox() {
+    const auto inbox = std::atomic_load(&inbox_);
+    if (!inbox) return 0;
+    
+    const auto guard = std::atomic_load(&replay_guard_);
+    size_t replayed = 0;
+    for (const auto& entry : inbox->pending()) {
+        WebhookEventView view;
+        if (!parseWebhookEventView(entry.payload, view)) {
+            inbox->acknowledge(entry.sequence);
+            continue;
+        }
+        if (entry.attempts >= max_replay_attempts_) {
+            deadLetter(*inbox, entry);
+            continue;
+        }
+        view.signature = entry.signature;
+        // A redelivery of the same event after restart is then a duplicate.
+        if (guard && !view.id.empty()) guard->insert(view.id);
+        // Counted before dispatch, so an entry that crashes the process is
+        // also given up on eventually.
+        const uint32_t attempts = inbox->recordAttempt(entry.sequence);
+        bool queued;
+        try {
+            queued = dispatch(view, nullptr, inbox, entry.sequence);
+        } catch (...) {
+            // A synchronous callback threw; the rest of the inbox still gets replayed.
+            if (attempts >= max_replay_attempts_) {
+                WebhookInbox::Entry failed = entry;
+                failed.attempts = attempts;
+                deadLetter(*inbox, failed);
+            }
+            continue;
+        }
+        if (!queued) break;
+        ++replayed;
+    }
+    return replayed;
+}
+
+std::string_view WebhookHandler::orderingKey(const WebhookEventView& event) {
+    for (std::string_view name : {"license_id", "user_id", "id"}) {
+        const std::string_view key = findMember(event.data, name);
+        if (!key.empty()) return key;
+    }
+    return {};
+}
+
+// Configuration
+void WebhookHandler::setSecret(const std::string& secret) {
+    setSecrets({secret});
+}
+
+void WebhookHandler::setTolerance(int toleranceSeconds) {
+    tolerance_seconds_ = toleranceSeconds;
+    if (isReplayProtectionEnabled()) enableReplayProtection(replay_events_per_second_);
+}
+
+void WebhookHandler::setSecrets(const std::vector<std::string>& secrets) {
+    std::lock_guard<std::mutex> lock(keyring_mutex_);
+    installKeyring(secrets);
+}
+
+void WebhookHandler::addSecret(const std::string& secret) {
+    std::lock_guard<std::mutex> lock(keyring_mutex_);
+    auto secrets = keyring()->secrets;
+    if (std::find(secrets.begin(), secrets.end(), secret) != secrets.end()) return;
+    secrets.push_back(secret);
+    installKeyring(std::move(secrets));
+}
+
+void WebhookHandler::removeSecret(const std::string& secret) {
+    std::lock_guard<std::mutex> lock(keyring_mutex_);
+    auto secrets = keyring()->secrets;
+    secrets.erase(std::remove(secrets.begin(), secrets.end(), secret), secrets.end());
+    installKeyring(std::move(secrets));
+}
+
+std::vector<std::string> WebhookHandler::getSecrets() const {
+    return keyring()->secrets;
+}
+
+// Utility methods
+std::string WebhookHandler::createSignature(const std::string& payload, const std::string& secret) {
+    return Utils::createWebhookSignature(payload, secret);
+}
+
+bool WebhookHandler::verifyTimestamp(std::string_view timestamp, int toleranceSeconds) {
+    using namespace std::chrono;
+    system_clock::time_point sent;
+
+    // Either Unix seconds or an RFC 3339 timestamp.
+    if (!parseEventTime(timestamp, sent) && !Utils::tryParseTimestamp(timestamp, sent)) {
+        return false;
+    }
+
+    const auto skew = duration_cast<std::chrono::seconds>(system_clock::now() - sent).count();
+    return std::llabs(skew) <= toleranceSeconds;
+}
+
+std::string WebhookHandler::getEventType(const std::string& payload) {
+    WebhookEventView view;
+    return parseWebhookEventView(payload, view) ? std::string(view.type) : std::string();
+}
+
+// Private helpers
+void WebhookHandler::registerDefaultCallbacks() {
+    // No built-in handlers; reserve the table rows of the built-in event types.
+    event_callbacks_.resize(KNOWN_EVENT_COUNT);
+    for (size_t i = 0; i < KNOWN_EVENT_COUNT; ++i) event_callbacks_[i].priority = KNOWN_EVENT_PRIORITIES[i];
+}
+
+size_t WebhookHandler::registerEventType(const std::string& eventType) {
+    const int known = knownEventId(eventType);
+    if (known >= 0) return static_cast<size_t>(known);
+    
+    auto it = std::lower_bound(custom_event_ids_.begin(), custom_event_ids_.end(), eventType,
+                               [](const auto& entry, const std::string& name) { return entry.first < name; });
+    if (it != custom_event_ids_.end() && it->first == eventType) return it->second;
+    
+    const size_t id = event_callbacks_.size();
+    event_callbacks_.emplace_back();
+    custom_event_ids_.insert(it, {eventType, id});
+    return id;
+}
+
+const WebhookHandler::Callbacks* WebhookHandler::findCallbacks(std::string_view eventType) const {
+    const int known = knownEventId(eventType);
+    if (known >= 0) return &event_callbacks_[static_cast<size_t>(known)];
+    if (custom_event_ids_.empty()) return nullptr;
+    
+    auto it = std::lower_bound(custom_event_ids_.begin(), custom_event_ids_.end(), eventType,
+                               [](const auto& entry, std::string_view name) { return entry.first < name; });
+    if (it == custom_event_ids_.end() || it->first != eventType) return nullptr;
+    return &event_callbacks_[it->second];
+}
+
+void WebhookHandler::installKeyring(std::vector<std::string> secrets) {
+    auto ring = std::make_shared<Keyring>();
+    ring->verifiers.reserve(secrets.size());
+    for (const auto& secret : secrets) ring->verifiers.emplace_back(secret);
+    ring->secrets = std::move(secrets);
+    std::atomic_store(&keyring_, std::shared_ptr<const Keyring>(std::move(ring)));
+}
+
+std::shared_ptr<const WebhookHandler::Keyring> WebhookHandler::keyring() const {
+    return std::atomic_load(&keyring_);
+}
+
+double WebhookHandler::loadPressure(const LoadSheddingOptions& options) const {
+    const size_t inFlight = in_flight_.load(std::memory_order_relaxed);
+    double pressure = static_cast<double>(inFlight) / static_cast<double>(options.max_in_flight);
+    // Latency only counts while work is outstanding, so an idle handler
+    // recovers even if nothing has completed since the last slow event.
+    if (inFlight > 0) {
+        const double target = static_cast<double>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(options.target_latency).count());
+        pressure = std::max(pressure, static_cast<double>(latency_ns_.load(std::memory_order_relaxed)) / target);
+    }
+    return pressure;
+}
+
+bool WebhookHandler::admit(EventPriority priority, const LoadSheddingOptions& options) const {
+    if (priority == EventPriority::Critical) {
+        return in_flight_.load(std::memory_order_relaxed) < options.max_in_flight;
+    }
+    return loadPressure(options) < SHED_THRESHOLDS[static_cast<size_t>(priority)];
+}
+
+void WebhookHandler::finishEvent(std::chrono::steady_clock::time_point admitted, bool completed) {
+    if (completed) {
+        const int64_t sample = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - admitted).count();
+        // EWMA with weight 1/8; racing updates only lose a sample.
+        const int64_t previous = latency_ns_.load(std::memory_order_relaxed);
+        latency_ns_.store(previous + (sample - previous) / 8, std::memory_order_relaxed);
+    }
+    in_flight_.fetch_sub(1, std::memory_order_relaxed);
+}
+
+bool WebhookHandler::dispatch(const WebhookEventView& view, const WebhookEvent* event,
+                              const std::shared_ptr<WebhookInbox>& inbox, uint64_t entry) {
+    // In-flight events and their latency are only tracked while shedding is on.
+    const bool tracked = std::atomic_load(&shedding_options_) != nullptr;
+    const auto admitted = tracked ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point();
+    if (tracked) in_flight_.fetch_add(1, std::memory_order_relaxed);
+    
+    struct Completion {
+        WebhookHandler* handler;
+        bool tracked;
+        std::chrono::steady_clock::time_point admitted;
+        ~Completion() {
+            if (tracked) handler->finishEvent(admitted, true);
+        }
+    };
+    
+    const auto dispatcher = std::atomic_load(&dispatcher_);
+    if (!dispatcher || !findCallbacks(view.type)) {
+        Completion completion{this, tracked, admitted};
+        callEventCallbacks(view, event);
+        if (inbox) inbox->acknowledge(entry);
+        return true;
+    }
+    
+    // The view points into the caller's buffer, so the worker gets its own copy.
+    auto owned = std::make_shared<const WebhookEvent>(event ? *event : view.toEvent());
+    auto task = [this, owned, inbox, entry, tracked, admitted] {
+        Completion completion{this, tracked, admitted};
+        const WebhookEventView copy{owned->id, owned->type, owned->data, owned->timestamp, owned->signature};
+        callEventCallbacks(copy, owned.get());
+        if (inbox) inbox->acknowledge(entry);
+    };
+    
+    const std::string_view key = orderingKey(view);
+    bool queued;
+    if (key.empty()) {
+        queued = block_when_full_ ? dispatcher->post(std::move(task)) : dispatcher->tryPost(std::move(task));
+    } else {
+        const uint64_t hash = std::hash<std::string_view>{}(key);
+        queued = block_when_full_ ? dispatcher->post(hash, std::move(task)) : dispatcher->tryPost(hash, std::move(task));
+    }
+    if (!queued && tracked) finishEvent(admitted, false);
+    return queued;
+}
+
+void WebhookHandler::callEventCallbacks(const WebhookEventView& view, const WebhookEvent* event) {
+    const Callbacks* callbacks = findCallbacks(view.type);
+    if (!callbacks) return;
+    
+    for (const auto& callback : callbacks->views) {
+        callback(view);
+    }
+    if (callbacks->owning.empty()) return;
+    
+    // Owning callbacks share one copy, made only when one is registered.
+    std::optional<WebhookEvent> copy;
+    if (!event) event = &copy.emplace(view.toEvent());
+    for (const auto& callback : callbacks->owning) {
+        callback(*event);
+    }
+}
+
+std::string WebhookHandler::extractTimestamp(const std::string& payload) {
+    WebhookEventView view;
+    return parseWebhookEventView(payload, view) ? Utils::formatTimestamp(view.timestamp) : std::string();
+}
+
+bool WebhookHandler::isEventType(const std::string& eventType, const std::string& payload) {
+    WebhookEventView view;
+    return parseWebhookEventView(payload, view) && view.type == eventType;
+}
+
+} // namespace LicenseChain
@@ -0,0 +1,351 @@
+#include "licensechain/webhook_inbox.h"
+#include "licensechain/exceptions.h"
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define LICENSECHAIN_HAS_MMAP 1
+#endif
+
+namespace LicenseChain {
+
+namespace {
+
+// On-disk record: header, payload, signature, padded to 8 bytes. A zero
+// type marks the end of the written part of a segment.
+struct RecordHeader {
+    uint32_t length;            // payload + signature bytes
+    uint32_t checksum;          // CRC-32 of the header (checksum zeroed) and body
+    uint64_t sequence;
+    uint32_t signature_length;
+    uint8_t type;
+    uint8_t reserved[3];
+};
+static_assert(sizeof(RecordHeader) == 24, "unexpected record header layout");
+
+constexpr uint8_t RECORD_EVENT = 1;
+constexpr uint8_t RECORD_ACK = 2;
+constexpr uint8_t RECORD_ATTEMPT = 3;
+
+constexpr size_t align8(size_t n) {
+    return (n + 7) & ~static_cast<size_t>(7);
+}
+
+constexpr std::array<uint32_t, 256> buildCrcTable() {
+    std::array<uint32_t, 256> table{};
+    for (uint32_t i = 0; i < 256; ++i) {
+        uint32_t c = i;
+        for (int k = 0; k < 8; ++k) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+        table[i] = c;
+    }
+    return table;
+}
+
+constexpr std::array<uint32_t, 256> CRC_TABLE = buildCrcTable();
+
+uint32_t crc32(uint32_t crc, const void* data, size_t length) {
+    const auto* p = static_cast<const uint8_t*>(data);
+    crc = ~crc;
+    for (size_t i = 0; i < length; ++i) crc = CRC_TABLE[(crc ^ p[i]) & 0xFF] ^ (crc >> 8);
+    return ~crc;
+}
+
+uint32_t recordChecksum(RecordHeader header, const char* body) {
+    header.checksum = 0;
+    return crc32(crc32(0, &header, sizeof(header)), body, header.length);
+}
+
+[[noreturn]] void fail(const std::string& what) {
+    throw LicenseChainException("STORAGE_ERROR", what + ": " + std::strerror(errno));
+}
+
+std::string segmentName(uint64_t id) {
+    char name[40];
+    std::snprintf(name, sizeof(name), "segment-%020llu.log", static_cast<unsigned long long>(id));
+    return name;
+}
+
+#ifdef LICENSECHAIN_HAS_MMAP
+void syncRange(char* base, size_t from, size_t to) {
+    if (from >= to) return;
+    const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    const size_t start = from / page * page;
+    if (msync(base + start, to - start, MS_SYNC) != 0) fail("msync failed");
+}
+#endif
+
+} // namespace
+
+#ifdef LICENSECHAIN_HAS_MMAP
+
+WebhookInbox::Segment::~Segment() {
+    if (data) munmap(data, size);
+    if (fd >= 0) ::close(fd);
+}
+
+WebhookInbox::WebhookInbox(const std::string& directory, size_t segmentSize)
+    : directory_(directory), segment_size_(std::max<size_t>(align8(segmentSize), 4096)) {
+    std::error_code ec;
+    std::filesystem::create_directories(directory_, ec);
+    if (ec) throw LicenseChainException("STORAGE_ERROR", "Cannot create inbox directory " + directory_ + ": " + ec.message());
+    recover();
+}
+
+WebhookInbox::~WebhookInbox() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    flushed_.wait(lock, [this] { return !flushing_; });
+    if (!segments_.empty()) {
+        try {
+            syncRange(segments_.back()->data, sync_offset_, offset_);
+        } catch (...) {
+        }
+    }
+}
+
+uint64_t WebhookInbox::append(std::string_view payload, std::string_view signature) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    const uint64_t sequence = next_sequence_++;
+    writeRecord(RECORD_EVENT, sequence, payload, signature);
+
+    // Group commit: one caller syncs everything written so far; callers
+    // arriving meanwhile wait for it or lead the next round.
+    while (durable_sequence_ < sequence) {
+        if (flushing_) {
+            flushed_.wait(lock);
+            continue;
+        }
+        flushing_ = true;
+        Segment* segment = segments_.back().get();
+        const size_t from = sync_offset_, to = offset_;
+        const uint64_t upto = next_sequence_ - 1;
+        lock.unlock();
+        try {
+            syncRange(segment->data, from, to);
+        } catch (...) {
+            lock.lock();
+            flushing_ = false;
+            flushed_.notify_all();
+            throw;
+        }
+        lock.lock();
+        if (segment == segments_.back().get()) sync_offset_ = std::max(sync_offset_, to);
+        durable_sequence_ = std::max(durable_sequence_, upto);
+        flushing_ = false;
+        ++commits_;
+        flushed_.notify_all();
+    }
+    return sequence;
+}
+
+void WebhookInbox::acknowledge(uint64_t sequence) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = unacknowledged_.find(sequence);
+    if (it == unacknowledged_.end()) return;
+    --it->second.segment->unacknowledged;
+    unacknowledged_.erase(it);
+    writeRecord(RECORD_ACK, sequence, {}, {});
+    releaseSegments();
+}
+
+uint32_t WebhookInbox::recordAttempt(uint64_t sequence) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = unacknowledged_.find(sequence);
+    if (it == unacknowledged_.end()) return 0;
+    writeRecord(RECORD_ATTEMPT, sequence, {}, {});
+    return ++it->second.attempts;
+}
+
+std::vector<WebhookInbox::Entry> WebhookInbox::pending() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<Entry> entries;
+    entries.reserve(unacknowledged_.size());
+    for (const auto& [sequence, location] : unacknowledged_) {
+        RecordHeader header;
+        std::memcpy(&header, location.segment->data + location.offset, sizeof(header));
+        const char* body = location.segment->data + location.offset + sizeof(header);
+        const size_t payloadLength = header.length - header.signature_length;
+        entries.push_back(Entry{sequence, std::string(body, payloadLength),
+                                std::string(body + payloadLength, header.signature_length), location.attempts});
+    }
+    return entries;
+}
+
+size_t WebhookInbox::pendingCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return unacknowledged_.size();
+}
+
+uint64_t WebhookInbox::commits() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return commits_;
+}
+
+size_t WebhookInbox::segmentCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return segments_.size();
+}
+
+void WebhookInbox::recover() {
+    std::vector<std::filesystem::path> paths;
+    for (const auto& entry : std::filesystem::directory_iterator(directory_)) {
+        const std::string name = entry.path().filename().string();
+        if (name.rfind("segment-", 0) == 0 && entry.path().extension() == ".log") paths.push_back(entry.path());
+    }
+    std::sort(paths.begin(), paths.end());
+
+    for (size_t i = 0; i < paths.size(); ++i) {
+        const uint64_t id = std::strtoull(paths[i].filename().string().c_str() + 8, nullptr, 10);
+        segments_.push_back(openSegment(id, 0, false));
+        scan(*segments_.back(), i + 1 == paths.size());
+        next_segment_id_ = id + 1;
+    }
+
+    if (segments_.empty()) {
+        segments_.push_back(openSegment(next_segment_id_++, segment_size_, true));
+        offset_ = 0;
+    }
+    sync_offset_ = offset_;
+    durable_sequence_ = next_sequence_ - 1;
+    releaseSegments();
+}
+
+void WebhookInbox::scan(Segment& segment, bool active) {
+    size_t offset = 0;
+    while (offset + sizeof(RecordHeader) <= segment.size) {
+        RecordHeader header;
+        std::memcpy(&header, segment.data + offset, sizeof(header));
+        if (header.type == 0 || header.length > segment.size - offset - sizeof(header) ||
+            header.signature_length > header.length ||
+            recordChecksum(header, segment.data + offset + sizeof(header)) != header.checksum) {
+            break;  // end of log, or a record torn by a crash
+        }
+        if (header.type == RECORD_EVENT) {
+            unacknowledged_[header.sequence] = Location{&segment, offset};
+            ++segment.unacknowledged;
+            next_sequence_ = std::max(next_sequence_, header.sequence + 1);
+        } else if (header.type == RECORD_ACK) {
+            auto it = unacknowledged_.find(header.sequence);
+            if (it != unacknowledged_.end()) {
+                --it->second.segment->unacknowledged;
+                unacknowledged_.erase(it);
+            }
+        } else if (header.type == RECORD_ATTEMPT) {
+            auto it = unacknowledged_.find(header.sequence);
+            if (it != unacknowledged_.end()) ++it->second.attempts;
+        }
+        offset += align8(sizeof(header) + header.length);
+    }
+
+    if (active) {
+        // Clear anything after the last good record so a torn tail is not
+        // mistaken for data once it is partly overwritten.
+        if (offset < segment.size) std::memset(segment.data + offset, 0, segment.size - offset);
+        offset_ = offset;
+    }
+}
+
+std::unique_ptr<WebhookInbox::Segment> WebhookInbox::openSegment(uint64_t id, size_t size, bool create) {
+    const std::string path = directory_ + "/" + segmentName(id);
+    auto segment = std::make_unique<Segment>();
+    segment->path = path;
+    segment->id = id;
+    segment->fd = ::open(path.c_str(), O_RDWR | O_CLOEXEC | (create ? O_CREAT | O_EXCL : 0), 0600);
+    if (segment->fd < 0) fail("Cannot open inbox segment " + path);
+
+    if (create) {
+        if (ftruncate(segment->fd, static_cast<off_t>(size)) != 0) fail("Cannot size inbox segment " + path);
+        // Make the new file's directory entry durable before writing into it.
+        const int dir = ::open(directory_.c_str(), O_RDONLY | O_CLOEXEC);
+        if (dir >= 0) {
+            fsync(dir);
+            ::close(dir);
+        }
+    } else {
+        struct stat st;
+        if (fstat(segment->fd, &st) != 0) fail("Cannot stat inbox segment " + path);
+        size = static_cast<size_t>(st.st_size);
+    }
+    segment->size = size;
+    if (size > 0) {
+        void* data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, segment->fd, 0);
+        if (data == MAP_FAILED) fail("Cannot map inbox segment " + path);
+        segment->data = static_cast<char*>(data);
+    }
+    return segment;
+}
+
+void WebhookInbox::rotate(size_t needed) {
+    // The tail of the old segment is synced here so durable_sequence_ stays
+    // exact; rotation happens once per segment.
+    Segment& current = *segments_.back();
+    syncRange(current.data, sync_offset_, offset_);
+
+    segments_.push_back(openSegment(next_segment_id_++, std::max(segment_size_, align8(needed)), true));
+    offset_ = 0;
+    sync_offset_ = 0;
+}
+
+void WebhookInbox::writeRecord(uint8_t type, uint64_t sequence, std::string_view payload, std::string_view signature) {
+    RecordHeader header{};
+    header.length = static_cast<uint32_t>(payload.size() + signature.size());
+    header.sequence = sequence;
+    header.signature_length = static_cast<uint32_t>(signature.size());
+    header.type = type;
+
+    const size_t size = align8(sizeof(header) + header.length);
+    if (offset_ + size > segments_.back()->size) rotate(size);
+
+    Segment& segment = *segments_.back();
+    char* out = segment.data + offset_;
+    std::memcpy(out + sizeof(header), payload.data(), payload.size());
+    std::memcpy(out + sizeof(header) + payload.size(), signature.data(), signature.size());
+    header.checksum = recordChecksum(header, out + sizeof(header));
+    std::memcpy(out, &header, sizeof(header));
+
+    if (type == RECORD_EVENT) {
+        unacknowledged_[sequence] = Location{&segment, offset_};
+        ++segment.unacknowledged;
+    }
+    offset_ += size;
+}
+
+void WebhookInbox::releaseSegments() {
+    // Only whole leading segments go, and never while a flush may be reading
+    // one; acknowledgements always follow their entries, so dropping a prefix
+    // cannot revive an entry.
+    if (flushing_) return;
+    while (segments_.size() > 1 && segments_.front()->unacknowledged == 0) {
+        ::unlink(segments_.front()->path.c_str());
+        segments_.pop_front();
+    }
+}
+
+#else
+
+WebhookInbox::Segment::~Segment() = default;
+
+WebhookInbox::WebhookInbox(const std::string& directory, size_t segmentSize)
+    : directory_(directory), segment_size_(segmentSize) {
+    throw ConfigurationException("WebhookInbox requires memory-mapped files");
+}
+
+WebhookInbox::~WebhookInbox() = default;
+uint64_t WebhookInbox::append(std::string_view, std::string_view) { return 0; }
+void WebhookInbox::acknowledge(uint64_t) {}
+uint32_t WebhookInbox::recordAttempt(uint64_t) { return 0; }
+std::vector<WebhookInbox::Entry> WebhookInbox::pending() const { return {}; }
+size_t WebhookInbox::pendingCount() const { return 0; }
+uint64_t WebhookInbox::commits() const { return 0; }
+size_t WebhookInbox::segmentCount() const { return 0; }
+
+#endif
+
+} // namespace LicenseChain
@@ -0,0 +1,582 @@
+#include "licensechain/webhook_server.h"
+#include "licensechain/exceptions.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iterator>
+#include <string_view>
+
+#ifdef __linux__
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <cerrno>
+#include <unordered_map>
+#endif
+
+namespace LicenseChain {
+
+#ifdef __linux__
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Responses are fixed strings so answering never formats or allocates.
+constexpr std::string_view RESPONSE_CONTINUE = "HTTP/1.1 100 Continue\r\n\r\n";
+constexpr std::string_view RESPONSE_OK = "HTTP/1.1 200 OK\r\nContent-Length: 0\r\n\r\n";
+constexpr std::string_view RESPONSE_UNAUTHORIZED = "HTTP/1.1 401 Unauthorized\r\nContent-Length: 0\r\n\r\n";
+constexpr std::string_view RESPONSE_UNPROCESSABLE = "HTTP/1.1 422 Unprocessable Entity\r\nContent-Length: 0\r\n\r\n";
+constexpr std::string_view RESPONSE_SERVER_ERROR =
+    "HTTP/1.1 500 Internal Server Error\r\nContent-Length: 0\r\n\r\n";
+constexpr std::string_view RESPONSE_NOT_FOUND = "HTTP/1.1 404 Not Found\r\nContent-Length: 0\r\n\r\n";
+constexpr std::string_view RESPONSE_METHOD_NOT_ALLOWED =
+    "HTTP/1.1 405 Method Not Allowed\r\nAllow: POST\r\nContent-Length: 0\r\n\r\n";
+// Errors after which the stream position is unknown close the connection.
+constexpr std::string_view RESPONSE_BAD_REQUEST =
+    "HTTP/1.1 400 Bad Request\r\nConnection: close\r\nContent-Length: 0\r\n\r\n";
+constexpr std::string_view RESPONSE_LENGTH_REQUIRED =
+    "HTTP/1.1 411 Length Required\r\nConnection: close\r\nContent-Length: 0\r\n\r\n";
+constexpr std::string_view RESPONSE_TOO_LARGE =
+    "HTTP/1.1 413 Payload Too Large\r\nConnection: close\r\nContent-Length: 0\r\n\r\n";
+
+constexpr int SWEEP_INTERVAL_MS = 1000;
+constexpr int ACCEPT_BACKOFF_MS = 100;   // pause after running out of descriptors
+
+bool iequals(std::string_view a, std::string_view b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        char x = a[i], y = b[i];
+        if (x >= 'A' && x <= 'Z') x = static_cast<char>(x + 32);
+        if (y >= 'A' && y <= 'Z') y = static_cast<char>(y + 32);
+        if (x != y) return false;
+    }
+    return true;
+}
+
+std::string_view trim(std::string_view s) {
+    while (!s.empty() && (s.front() == ' ' || s.front() == '\t')) s.remove_prefix(1);
+    while (!s.empty() && (s.back() == ' ' || s.back() == '\t')) s.remove_suffix(1);
+    return s;
+}
+
+std::string_view responseFor(WebhookResult result, std::string_view unavailable) {
+    switch (result) {
+        case WebhookResult::Accepted:
+        case WebhookResult::Duplicate: return RESPONSE_OK;  // already delivered; stop redelivery
+        case WebhookResult::InvalidTimestamp:
+        case WebhookResult::InvalidSignature: return RESPONSE_UNAUTHORIZED;
+        case WebhookResult::InvalidPayload: return RESPONSE_UNPROCESSABLE;
+        case WebhookResult::Rejected:
+        case WebhookResult::Shed: return unavailable;
+    }
+    return RESPONSE_BAD_REQUEST;
+}
+
+[[noreturn]] void failSystem(const std::string& what) {
+    throw NetworkException(what + ": " + std::strerror(errno));
+}
+
+} // namespace
+
+class WebhookServer::Loop {
+public:
+    Loop(WebhookServer& server, int listenFd) : server_(server), listen_fd_(listenFd) {
+        epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+        wake_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        try {
+            if (epoll_fd_ < 0 || wake_fd_ < 0) failSystem("Failed to create event loop");
+            if (!watch(listen_fd_, EPOLLIN, EPOLL_CTL_ADD) || !watch(wake_fd_, EPOLLIN, EPOLL_CTL_ADD)) {
+                failSystem("epoll_ctl failed");
+            }
+        } catch (...) {
+            if (epoll_fd_ >= 0) ::close(epoll_fd_);
+            if (wake_fd_ >= 0) ::close(wake_fd_);
+            ::close(listen_fd_);
+            throw;
+        }
+    }
+
+    ~Loop() {
+        stop();
+        for (auto& entry : connections_) closeSocket(entry.second);
+        if (epoll_fd_ >= 0) ::close(epoll_fd_);
+        if (wake_fd_ >= 0) ::close(wake_fd_);
+        ::close(listen_fd_);
+    }
+
+    void start() {
+        thread_ = std::thread([this] { run(); });
+    }
+
+    void stop() {
+        if (!thread_.joinable()) return;
+        stopping_ = true;
+        const uint64_t one = 1;
+        [[maybe_unused]] const ssize_t written = ::write(wake_fd_, &one, sizeof(one));
+        thread_.join();
+    }
+
+private:
+    enum class Parse { NeedMore, Ready, Stopped };
+
+    struct Connection {
+        int fd = -1;
+        std::unique_ptr<std::vector<char>> buffer;
+        size_t used = 0;
+        size_t scanned = 0;          // bytes already searched for the header terminator
+        size_t body_offset = 0;      // 0 until the header has been parsed
+        size_t body_length = 0;
+        std::string_view signature;  // slices of *buffer, valid while the header is
+        std::string_view timestamp;
+        bool keep_alive = true;
+        bool writing = false;
+        std::string_view pending;    // unsent tail of a static response
+        bool close_after_write = false;
+        Clock::time_point last_active;
+    };
+
+    bool watch(int fd, uint32_t events, int op) {
+        epoll_event ev{};
+        ev.events = events;
+        ev.data.fd = fd;
+        return epoll_ctl(epoll_fd_, op, fd, &ev) == 0;
+    }
+
+    void run() {
+        epoll_event events[256];
+        const int timeout = std::min(SWEEP_INTERVAL_MS, std::max(1, server_.config_.idle_timeout_ms));
+        auto lastSweep = Clock::now();
+        while (!stopping_) {
+            const int n = epoll_wait(epoll_fd_, events, 256, accept_paused_ ? std::min(timeout, ACCEPT_BACKOFF_MS) : timeout);
+            if (n < 0 && errno != EINTR) break;
+            for (int i = 0; i < n; ++i) {
+                const int fd = events[i].data.fd;
+                if (fd == listen_fd_) {
+                    acceptConnections();
+                } else if (fd != wake_fd_) {
+                    auto it = connections_.find(fd);
+                    if (it == connections_.end()) continue;
+                    if (events[i].events & (EPOLLERR | EPOLLHUP)) {
+                        closeConnection(it);
+                    } else if (events[i].events & EPOLLOUT) {
+                        onWritable(it);
+                    } else {
+                        onReadable(it);
+                    }
+                }
+            }
+            const auto now = Clock::now();
+            if (accept_paused_ && now >= accept_resume_) resumeAccepting();
+            if (now - lastSweep >= std::chrono::milliseconds(timeout)) {
+                sweepIdle(now);
+                lastSweep = now;
+            }
+        }
+    }
+
+    void acceptConnections() {
+        for (;;) {
+            const int fd = accept4(listen_fd_, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+            if (fd < 0) {
+                // The listener is level-triggered and stays readable while
+                // descriptors are exhausted; stop watching it for a while
+                // instead of spinning on it.
+                if (errno == EMFILE || errno == ENFILE || errno == ENOBUFS || errno == ENOMEM) pauseAccepting();
+                return;  // EAGAIN, or a transient error the next wakeup retries
+            }
+
+            if (server_.connections_.fetch_add(1) >= server_.config_.max_connections) {
+                server_.connections_.fetch_sub(1);
+                server_.refused_connections_.fetch_add(1, std::memory_order_relaxed);
+                ::close(fd);
+                continue;
+            }
+            const int one = 1;
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+            auto it = connections_.emplace(fd, Connection{}).first;
+            Connection& conn = it->second;
+            conn.fd = fd;
+            conn.buffer = acquireBuffer();
+            conn.last_active = Clock::now();
+            // Runs on the loop thread, where throwing would terminate the process.
+            if (!watch(fd, EPOLLIN | EPOLLRDHUP, EPOLL_CTL_ADD)) {
+                closeConnection(it);
+                server_.refused_connections_.fetch_add(1, std::memory_order_relaxed);
+                continue;
+            }
+            server_.accepted_connections_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    void pauseAccepting() {
+        if (!accept_paused_) watch(listen_fd_, 0, EPOLL_CTL_MOD);
+        accept_paused_ = true;
+        accept_resume_ = Clock::now() + std::chrono::milliseconds(ACCEPT_BACKOFF_MS);
+    }
+
+    void resumeAccepting() {
+        accept_paused_ = false;
+        watch(listen_fd_, EPOLLIN, EPOLL_CTL_MOD);
+    }
+
+    void onReadable(std::unordered_map<int, Connection>::iterator it) {
+        Connection& conn = it->second;
+        conn.last_active = Clock::now();
+        for (;;) {
+            std::vector<char>& buffer = *conn.buffer;
+            if (conn.used == buffer.size()) {
+                // Room for the body was reserved once the header was parsed, so
+                // a full buffer here means the header itself is too large.
+                respond(it, RESPONSE_BAD_REQUEST, true);
+                return;
+            }
+            const ssize_t n = ::recv(conn.fd, buffer.data() + conn.used, buffer.size() - conn.used, 0);
+            if (n > 0) {
+                conn.used += static_cast<size_t>(n);
+                if (!processRequests(it)) return;
+                continue;
+            }
+            if (n == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+                closeConnection(it);
+            }
+            return;
+        }
+    }
+
+    // Handles every complete request in the buffer. Returns false once the
+    // connection is closed or waiting to flush a response.
+    bool processRequests(std::unordered_map<int, Connection>::iterator it) {
+        Connection& conn = it->second;
+        for (;;) {
+            if (conn.body_offset == 0) {
+                const Parse state = parseHeader(it);
+                if (state != Parse::Ready) return state == Parse::NeedMore;
+            }
+
+            const size_t end = conn.body_offset + conn.body_length;
+            if (conn.used < end) return true;
+
+            const char* data = conn.buffer->data();
+            const std::string_view body(data + conn.body_offset, conn.body_length);
+            server_.requests_.fetch_add(1, std::memory_order_relaxed);
+            std::string_view response;
+            try {
+                response = responseFor(server_.handler_.receiveWebhook(body, conn.signature, conn.timestamp),
+                                       server_.unavailable_response_);
+            } catch (...) {
+                // A throwing callback or storage failure must not stop the loop;
+                // the sender retries on 500.
+                response = RESPONSE_SERVER_ERROR;
+            }
+            (response == RESPONSE_OK ? server_.accepted_events_ : server_.rejected_events_)
+                .fetch_add(1, std::memory_order_relaxed);
+
+            // Shift any pipelined bytes to the front for the next request.
+            const size_t rest = conn.used - end;
+            if (rest > 0) std::memmove(conn.buffer->data(), data + end, rest);
+            conn.used = rest;
+            conn.scanned = 0;
+            conn.body_offset = 0;
+            conn.signature = conn.timestamp = {};
+
+            if (!respond(it, response, !conn.keep_alive)) return false;
+        }
+    }
+
+    // Parses the request header once it is complete. Stopped means the
+    // request was answered with an error and the connection is closing.
+    Parse parseHeader(std::unordered_map<int, Connection>::iterator it) {
+        Connection& conn = it->second;
+        const std::string_view received(conn.buffer->data(), conn.used);
+        const size_t from = conn.scanned > 3 ? conn.scanned - 3 : 0;
+        const size_t headerEnd = received.find("\r\n\r\n", from);
+        if (headerEnd == std::string_view::npos) {
+            conn.scanned = conn.used;
+            return Parse::NeedMore;
+        }
+
+        std::string_view header = received.substr(0, headerEnd + 2);
+        const size_t lineEnd = header.find("\r\n");
+        const std::string_view requestLine = header.substr(0, lineEnd);
+        header.remove_prefix(lineEnd + 2);
+
+        const size_t methodEnd = requestLine.find(' ');
+        const size_t targetEnd = requestLine.find(' ', methodEnd + 1);
+        if (methodEnd == std::string_view::npos || targetEnd == std::string_view::npos) {
+            respond(it, RESPONSE_BAD_REQUEST, true);
+            return Parse::Stopped;
+        }
+        const std::string_view method = requestLine.substr(0, methodEnd);
+        std::string_view target = requestLine.substr(methodEnd + 1, targetEnd - methodEnd - 1);
+        target = target.substr(0, target.find('?'));
+        conn.keep_alive = requestLine.substr(targetEnd + 1) != "HTTP/1.0";
+
+        bool hasLength = false, chunked = false, expectContinue = false;
+        size_t length = 0;
+        while (!header.empty()) {
+            const size_t end = header.find("\r\n");
+            const std::string_view line = header.substr(0, end);
+            header.remove_prefix(end + 2);
+            const size_t colon = line.find(':');
+            if (colon == std::string_view::npos) continue;
+            const std::string_view name = trim(line.substr(0, colon));
+            const std::string_view value = trim(line.substr(colon + 1));
+
+            if (iequals(name, "Content-Length")) {
+                hasLength = !value.empty();
+                length = 0;
+                for (char c : value) {
+                    if (c < '0' || c > '9') {
+                        respond(it, RESPONSE_BAD_REQUEST, true);
+                        return Parse::Stopped;
+                    }
+                    // Saturate; anything past the limit is rejected below.
+                    if (length <= server_.config_.max_body_size) length = length * 10 + static_cast<size_t>(c - '0');
+                }
+            } else if (iequals(name, server_.config_.signature_header)) {
+                conn.signature = value;
+            } else if (iequals(name, server_.config_.timestamp_header)) {
+                conn.timestamp = value;
+            } else if (iequals(name, "Transfer-Encoding")) {
+                chunked = true;
+            } else if (iequals(name, "Connection")) {
+                if (iequals(value, "close")) conn.keep_alive = false;
+                else if (iequals(value, "keep-alive")) conn.keep_alive = true;
+            } else if (iequals(name, "Expect")) {
+                expectContinue = iequals(value, "100-continue");
+            }
+        }
+
+        if (chunked || !hasLength) {
+            respond(it, RESPONSE_LENGTH_REQUIRED, true);
+            return Parse::Stopped;
+        }
+        if (length > server_.config_.max_body_size) {
+            respond(it, RESPONSE_TOO_LARGE, true);
+            return Parse::Stopped;
+        }
+
+        // Requests that will not be handled are answered without reading the
+        // body, so the connection cannot be reused.
+        if (method != "POST") {
+            respond(it, RESPONSE_METHOD_NOT_ALLOWED, true);
+            return Parse::Stopped;
+        }
+        if (!server_.config_.path.empty() && target != server_.config_.path) {
+            respond(it, RESPONSE_NOT_FOUND, true);
+            return Parse::Stopped;
+        }
+        conn.body_offset = headerEnd + 4;
+        conn.body_length = length;
+        if (conn.buffer->size() < conn.body_offset + length) {
+            // Growing may move the buffer; keep the header slices valid.
+            const char* old = conn.buffer->data();
+            conn.buffer->resize(conn.body_offset + length);
+            const char* moved = conn.buffer->data();
+            if (!conn.signature.empty()) conn.signature = std::string_view(moved + (conn.signature.data() - old), conn.signature.size());
+            if (!conn.timestamp.empty()) conn.timestamp = std::string_view(moved + (conn.timestamp.data() - old), conn.timestamp.size());
+        }
+
+        if (expectContinue && conn.used < conn.body_offset + length) {
+            return respond(it, RESPONSE_CONTINUE, false) ? Parse::Ready : Parse::Stopped;
+        }
+        return Parse::Ready;
+    }
+
+    // Sends a static response. Returns false if the connection was closed or
+    // the response did not fit in the socket buffer.
+    bool respond(std::unordered_map<int, Connection>::iterator it, std::string_view response, bool close) {
+        Connection& conn = it->second;
+        conn.pending = response;
+        conn.close_after_write = close;
+        return flush(it);
+    }
+
+    bool flush(std::unordered_map<int, Connection>::iterator it) {
+        Connection& conn = it->second;
+        while (!conn.pending.empty()) {
+            const ssize_t n = ::send(conn.fd, conn.pending.data(), conn.pending.size(), MSG_NOSIGNAL);
+            if (n > 0) {
+                conn.pending.remove_prefix(static_cast<size_t>(n));
+                continue;
+            }
+            if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                if (!conn.writing) {
+                    conn.writing = true;
+                    watch(conn.fd, EPOLLOUT, EPOLL_CTL_MOD);
+                }
+                return false;
+            }
+            if (n < 0 && errno == EINTR) continue;
+            closeConnection(it);
+            return false;
+        }
+        if (conn.close_after_write) {
+            closeConnection(it);
+            return false;
+        }
+        if (conn.writing) {
+            conn.writing = false;
+            watch(conn.fd, EPOLLIN | EPOLLRDHUP, EPOLL_CTL_MOD);
+        }
+        return true;
+    }
+
+    void onWritable(std::unordered_map<int, Connection>::iterator it) {
+        it->second.last_active = Clock::now();
+        if (flush(it)) processRequests(it);
+    }
+
+    void sweepIdle(Clock::time_point now) {
+        const auto limit = std::chrono::milliseconds(server_.config_.idle_timeout_ms);
+        for (auto it = connections_.begin(); it != connections_.end();) {
+            auto next = std::next(it);
+            if (now - it->second.last_active > limit) closeConnection(it);
+            it = next;
+        }
+    }
+
+    void closeConnection(std::unordered_map<int, Connection>::iterator it) {
+        closeSocket(it->second);
+        connections_.erase(it);
+    }
+
+    void closeSocket(Connection& conn) {
+        epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, conn.fd, nullptr);
+        ::close(conn.fd);
+        releaseBuffer(std::move(conn.buffer));
+        server_.connections_.fetch_sub(1);
+        // A descriptor is free again.
+        if (accept_paused_) resumeAccepting();
+    }
+
+    std::unique_ptr<std::vector<char>> acquireBuffer() {
+        if (free_buffers_.empty()) {
+            return std::make_unique<std::vector<char>>(server_.config_.buffer_size);
+        }
+        auto buffer = std::move(free_buffers_.back());
+        free_buffers_.pop_back();
+        return buffer;
+    }
+
+    void releaseBuffer(std::unique_ptr<std::vector<char>> buffer) {
+        if (!buffer) return;
+        // Buffers grown for a large body go back to the pool at the base size.
+        if (buffer->size() > server_.config_.buffer_size) {
+            buffer->resize(server_.config_.buffer_size);
+            buffer->shrink_to_fit();
+        }
+        free_buffers_.push_back(std::move(buffer));
+    }
+
+    WebhookServer& server_;
+    int listen_fd_;
+    int epoll_fd_ = -1;
+    int wake_fd_ = -1;
+    std::atomic<bool> stopping_{false};
+    bool accept_paused_ = false;
+    Clock::time_point accept_resume_;
+    std::thread thread_;
+    std::unordered_map<int, Connection> connections_;
+    std::vector<std::unique_ptr<std::vector<char>>> free_buffers_;
+};
+
+WebhookServer::WebhookServer(WebhookHandler& handler, WebhookServerConfig config)
+    : handler_(handler), config_(std::move(config)) {
+    if (config_.threads == 0) config_.threads = 1;
+    if (config_.buffer_size < 1024) config_.buffer_size = 1024;
+    // Built once so shedding still answers from a fixed buffer.
+    unavailable_response_ = "HTTP/1.1 503 Service Unavailable\r\nRetry-After: " +
+                            std::to_string(std::max(config_.retry_after_seconds, 0)) +
+                            "\r\nContent-Length: 0\r\n\r\n";
+}
+
+WebhookServer::~WebhookServer() {
+    stop();
+}
+
+void WebhookServer::start() {
+    if (running_.load()) return;
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    if (inet_pton(AF_INET, config_.bind_address.c_str(), &address.sin_addr) != 1) {
+        throw ConfigurationException("Invalid bind address: " + config_.bind_address);
+    }
+
+    uint16_t port = config_.port;
+    try {
+        for (size_t i = 0; i < config_.threads; ++i) {
+            const int fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+            if (fd < 0) failSystem("Failed to create socket");
+
+            const int one = 1;
+            setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+            setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &one, sizeof(one));
+            address.sin_port = htons(port);
+            if (bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+                listen(fd, SOMAXCONN) != 0) {
+                ::close(fd);
+                failSystem("Failed to listen on " + config_.bind_address + ":" + std::to_string(port));
+            }
+
+            if (port == 0) {
+                sockaddr_in bound{};
+                socklen_t length = sizeof(bound);
+                getsockname(fd, reinterpret_cast<sockaddr*>(&bound), &length);
+                port = ntohs(bound.sin_port);
+            }
+            loops_.push_back(std::make_unique<Loop>(*this, fd));
+        }
+    } catch (...) {
+        loops_.clear();
+        throw;
+    }
+
+    port_ = port;
+    for (auto& loop : loops_) loop->start();
+    running_ = true;
+}
+
+void WebhookServer::stop() {
+    if (!running_.exchange(false)) return;
+    for (auto& loop : loops_) loop->stop();
+    loops_.clear();
+}
+
+#else
+
+class WebhookServer::Loop {};
+
+WebhookServer::WebhookServer(WebhookHandler& handler, WebhookServerConfig config)
+    : handler_(handler), config_(std::move(config)) {}
+
+WebhookServer::~WebhookServer() = default;
+
+void WebhookServer::start() {
+    throw ConfigurationException("WebhookServer is only available on Linux");
+}
+
+void WebhookServer::stop() {}
+
+#endif
+
+WebhookServerStats WebhookServer::stats() const {
+    WebhookServerStats s;
+    s.connections = connections_.load(std::memory_order_relaxed);
+    s.accepted_connections = accepted_connections_.load(std::memory_order_relaxed);
+    s.refused_connections = refused_connections_.load(std::memory_order_relaxed);
+    s.requests = requests_.load(std::memory_order_relaxed);
+    s.accepted_events = accepted_events_.load(std::memory_order_relaxed);
+    s.rejected_events = rejected_events_.load(std::memory_order_relaxed);
+    return s;
+}
+
+} // namespace LicenseChain
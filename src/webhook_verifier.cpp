@@ -0,0 +1,299 @@
+#include "licensechain/webhook_verifier.h"
+#include "licensechain/utils.h"
+#include "licensechain/exceptions.h"
+#include <openssl/evp.h>
+#include <openssl/crypto.h>
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace LicenseChain {
+
+namespace {
+
+constexpr size_t SHA256_BLOCK_SIZE = 64;
+
+// Chunk size for multi-key passes; small enough to stay in L1 across keys.
+constexpr size_t PASS_CHUNK_SIZE = 4096;
+
+// Batches smaller than this (in items and in bytes) are not worth a thread.
+constexpr size_t BATCH_ITEMS_PER_THREAD = 64;
+constexpr size_t BATCH_BYTES_PER_THREAD = 256 * 1024;
+// Items claimed per step so threads balance uneven payload sizes.
+constexpr size_t BATCH_CLAIM_SIZE = 16;
+
+[[noreturn]] void fail(const char* what) {
+    throw LicenseChainException("CRYPTO_ERROR", what);
+}
+
+EVP_MD_CTX* newContext() {
+    EVP_MD_CTX* ctx = EVP_MD_CTX_new();
+    if (!ctx) fail("EVP_MD_CTX_new failed");
+    return ctx;
+}
+
+EVP_MD_CTX* duplicate(const EVP_MD_CTX* source) {
+    EVP_MD_CTX* ctx = newContext();
+    if (EVP_MD_CTX_copy_ex(ctx, source) != 1) {
+        EVP_MD_CTX_free(ctx);
+        fail("EVP_MD_CTX_copy_ex failed");
+    }
+    return ctx;
+}
+
+EVP_MD_CTX* padState(const uint8_t* key, uint8_t mask) {
+    uint8_t block[SHA256_BLOCK_SIZE];
+    for (size_t i = 0; i < SHA256_BLOCK_SIZE; ++i) block[i] = key[i] ^ mask;
+
+    EVP_MD_CTX* ctx = newContext();
+    const bool ok = EVP_DigestInit_ex(ctx, EVP_sha256(), nullptr) == 1 &&
+                    EVP_DigestUpdate(ctx, block, sizeof(block)) == 1;
+    OPENSSL_cleanse(block, sizeof(block));
+    if (!ok) {
+        EVP_MD_CTX_free(ctx);
+        fail("SHA-256 initialisation failed");
+    }
+    return ctx;
+}
+
+// HMAC of one message from precomputed pad states, reusing ctx.
+bool computeMac(EVP_MD_CTX* ctx, const EVP_MD_CTX* inner, const EVP_MD_CTX* outer,
+                std::string_view message, uint8_t out[WebhookVerifier::DIGEST_SIZE]) {
+    uint8_t innerHash[WebhookVerifier::DIGEST_SIZE];
+    return EVP_MD_CTX_copy_ex(ctx, inner) == 1 &&
+           EVP_DigestUpdate(ctx, message.data(), message.size()) == 1 &&
+           EVP_DigestFinal_ex(ctx, innerHash, nullptr) == 1 &&
+           EVP_MD_CTX_copy_ex(ctx, outer) == 1 &&
+           EVP_DigestUpdate(ctx, innerHash, sizeof(innerHash)) == 1 &&
+           EVP_DigestFinal_ex(ctx, out, nullptr) == 1;
+}
+
+} // namespace
+
+// Stream
+
+WebhookVerifier::Stream::Stream(evp_md_ctx_st* inner, const evp_md_ctx_st* outer)
+    : ctx_(inner), outer_(outer) {}
+
+WebhookVerifier::Stream::Stream(Stream&& other) noexcept
+    : ctx_(std::exchange(other.ctx_, nullptr)), outer_(other.outer_) {}
+
+WebhookVerifier::Stream& WebhookVerifier::Stream::operator=(Stream&& other) noexcept {
+    if (this != &other) {
+        EVP_MD_CTX_free(ctx_);
+        ctx_ = std::exchange(other.ctx_, nullptr);
+        outer_ = other.outer_;
+    }
+    return *this;
+}
+
+WebhookVerifier::Stream::~Stream() {
+    EVP_MD_CTX_free(ctx_);
+}
+
+void WebhookVerifier::Stream::update(const void* data, size_t length) {
+    if (length > 0 && EVP_DigestUpdate(ctx_, data, length) != 1) fail("EVP_DigestUpdate failed");
+}
+
+void WebhookVerifier::Stream::digest(uint8_t out[DIGEST_SIZE]) {
+    uint8_t innerHash[DIGEST_SIZE];
+    if (EVP_DigestFinal_ex(ctx_, innerHash, nullptr) != 1 ||
+        EVP_MD_CTX_copy_ex(ctx_, outer_) != 1 ||
+        EVP_DigestUpdate(ctx_, innerHash, sizeof(innerHash)) != 1 ||
+        EVP_DigestFinal_ex(ctx_, out, nullptr) != 1) {
+        fail("HMAC finalisation failed");
+    }
+}
+
+bool WebhookVerifier::Stream::verify(std::string_view signature) {
+    uint8_t expected[DIGEST_SIZE];
+    if (!parseSignature(signature, expected)) return false;
+    return verify(expected);
+}
+
+bool WebhookVerifier::Stream::verify(const uint8_t expected[DIGEST_SIZE]) {
+    uint8_t actual[DIGEST_SIZE];
+    digest(actual);
+    return CRYPTO_memcmp(actual, expected, DIGEST_SIZE) == 0;
+}
+
+// WebhookVerifier
+
+WebhookVerifier::WebhookVerifier(std::string_view secret) : inner_(nullptr), outer_(nullptr) {
+    uint8_t key[SHA256_BLOCK_SIZE] = {};
+    if (secret.size() > SHA256_BLOCK_SIZE) {
+        if (EVP_Digest(secret.data(), secret.size(), key, nullptr, EVP_sha256(), nullptr) != 1) {
+            fail("SHA-256 of webhook secret failed");
+        }
+    } else {
+        std::copy(secret.begin(), secret.end(), key);
+    }
+
+    try {
+        inner_ = padState(key, 0x36);
+        outer_ = padState(key, 0x5c);
+    } catch (...) {
+        OPENSSL_cleanse(key, sizeof(key));
+        EVP_MD_CTX_free(inner_);
+        throw;
+    }
+    OPENSSL_cleanse(key, sizeof(key));
+}
+
+WebhookVerifier::WebhookVerifier(const WebhookVerifier& other)
+    : inner_(duplicate(other.inner_)), outer_(nullptr) {
+    try {
+        outer_ = duplicate(other.outer_);
+    } catch (...) {
+        EVP_MD_CTX_free(inner_);
+        throw;
+    }
+}
+
+WebhookVerifier::WebhookVerifier(WebhookVerifier&& other) noexcept
+    : inner_(std::exchange(other.inner_, nullptr)), outer_(std::exchange(other.outer_, nullptr)) {}
+
+WebhookVerifier& WebhookVerifier::operator=(WebhookVerifier other) noexcept {
+    std::swap(inner_, other.inner_);
+    std::swap(outer_, other.outer_);
+    return *this;
+}
+
+WebhookVerifier::~WebhookVerifier() {
+    EVP_MD_CTX_free(inner_);
+    EVP_MD_CTX_free(outer_);
+}
+
+WebhookVerifier::Stream WebhookVerifier::begin() const {
+    return Stream(duplicate(inner_), outer_);
+}
+
+std::string WebhookVerifier::sign(std::string_view payload) const {
+    uint8_t mac[DIGEST_SIZE];
+    Stream stream = begin();
+    stream.update(payload);
+    stream.digest(mac);
+
+    std::string hex(DIGEST_SIZE * 2, '\0');
+    Utils::toHex(mac, DIGEST_SIZE, &hex[0]);
+    return hex;
+}
+
+bool WebhookVerifier::verify(std::string_view payload, std::string_view signature) const {
+    uint8_t expected[DIGEST_SIZE];
+    if (!parseSignature(signature, expected)) return false;
+
+    Stream stream = begin();
+    stream.update(payload);
+    return stream.verify(expected);
+}
+
+std::vector<bool> WebhookVerifier::verifyBatch(const SignedPayload* items, size_t count, size_t threads) const {
+    return verifyBatch(this, 1, items, count, threads);
+}
+
+std::vector<bool> WebhookVerifier::verifyBatch(const std::vector<SignedPayload>& items, size_t threads) const {
+    return verifyBatch(this, 1, items.data(), items.size(), threads);
+}
+
+std::vector<bool> WebhookVerifier::verifyBatch(const std::vector<WebhookVerifier>& verifiers,
+                                               const SignedPayload* items, size_t count, size_t threads) {
+    return verifyBatch(verifiers.data(), verifiers.size(), items, count, threads);
+}
+
+std::vector<bool> WebhookVerifier::verifyBatch(const WebhookVerifier* verifiers, size_t verifierCount,
+                                               const SignedPayload* items, size_t count, size_t threads) {
+    // One byte per item while threads write, packed at the end: neighbouring
+    // bits of a vector<bool> cannot be written concurrently.
+    std::vector<uint8_t> matched(count, 0);
+    if (count == 0 || verifierCount == 0) return std::vector<bool>(count, false);
+
+    size_t bytes = 0;
+    for (size_t i = 0; i < count; ++i) bytes += items[i].first.size();
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    threads = std::min({threads, (count + BATCH_ITEMS_PER_THREAD - 1) / BATCH_ITEMS_PER_THREAD,
+                        std::max<size_t>(bytes / BATCH_BYTES_PER_THREAD, 1)});
+    threads = std::max<size_t>(threads, 1);
+
+    std::atomic<size_t> next{0};
+    auto work = [&] {
+        std::unique_ptr<EVP_MD_CTX, decltype(&EVP_MD_CTX_free)> ctx(newContext(), &EVP_MD_CTX_free);
+        uint8_t expected[DIGEST_SIZE];
+        uint8_t actual[DIGEST_SIZE];
+        for (;;) {
+            const size_t begin = next.fetch_add(BATCH_CLAIM_SIZE, std::memory_order_relaxed);
+            if (begin >= count) return;
+            const size_t end = std::min(begin + BATCH_CLAIM_SIZE, count);
+            for (size_t i = begin; i < end; ++i) {
+                if (!parseSignature(items[i].second, expected)) continue;
+                // Every verifier is computed so timing does not reveal which matched.
+                bool match = false;
+                for (size_t v = 0; v < verifierCount; ++v) {
+                    if (!computeMac(ctx.get(), verifiers[v].inner_, verifiers[v].outer_, items[i].first, actual)) {
+                        fail("HMAC computation failed");
+                    }
+                    match |= CRYPTO_memcmp(actual, expected, DIGEST_SIZE) == 0;
+                }
+                matched[i] = match;
+            }
+        }
+    };
+
+    if (threads == 1) {
+        work();
+    } else {
+        std::vector<std::thread> pool;
+        std::exception_ptr error;
+        std::mutex errorMutex;
+        pool.reserve(threads - 1);
+        auto guarded = [&] {
+            try {
+                work();
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(errorMutex);
+                if (!error) error = std::current_exception();
+                next.store(count);
+            }
+        };
+        for (size_t t = 1; t < threads; ++t) pool.emplace_back(guarded);
+        guarded();
+        for (auto& thread : pool) thread.join();
+        if (error) std::rethrow_exception(error);
+    }
+
+    return std::vector<bool>(matched.begin(), matched.end());
+}
+
+int WebhookVerifier::findMatch(const std::vector<WebhookVerifier>& verifiers,
+                               std::string_view payload, std::string_view signature) {
+    uint8_t expected[DIGEST_SIZE];
+    if (verifiers.empty() || !parseSignature(signature, expected)) return -1;
+
+    std::vector<Stream> streams;
+    streams.reserve(verifiers.size());
+    for (const auto& verifier : verifiers) streams.push_back(verifier.begin());
+
+    for (size_t offset = 0; offset < payload.size(); offset += PASS_CHUNK_SIZE) {
+        const std::string_view chunk = payload.substr(offset, PASS_CHUNK_SIZE);
+        for (auto& stream : streams) stream.update(chunk);
+    }
+
+    // Every digest is finished so timing does not reveal which key matched.
+    int match = -1;
+    for (size_t i = 0; i < streams.size(); ++i) {
+        if (streams[i].verify(expected) && match < 0) match = static_cast<int>(i);
+    }
+    return match;
+}
+
+bool WebhookVerifier::parseSignature(std::string_view signature, uint8_t out[DIGEST_SIZE]) {
+    if (signature.substr(0, 7) == "sha256=") signature.remove_prefix(7);
+    if (signature.size() != DIGEST_SIZE * 2) return false;
+    return Utils::fromHex(signature, out);
+}
+
+} // namespace LicenseChain
@@ -0,0 +1,95 @@
+// Base64 and hex throughput of the buffer codecs against the OpenSSL BIO and
+// stringstream code they replaced.
+
+#include "licensechain/utils.h"
+#include "../test_support.h"
+#include <iomanip>
+#include <openssl/bio.h>
+#include <openssl/buffer.h>
+#include <openssl/evp.h>
+#include <sstream>
+#include <vector>
+
+using namespace LicenseChain;
+
+namespace {
+
+std::string bioBase64Encode(const std::string& data) {
+    BIO* b64 = BIO_new(BIO_f_base64());
+    BIO* mem = BIO_new(BIO_s_mem());
+    b64 = BIO_push(b64, mem);
+    BIO_set_flags(b64, BIO_FLAGS_BASE64_NO_NL);
+    BIO_write(b64, data.data(), static_cast<int>(data.size()));
+    BIO_flush(b64);
+    BUF_MEM* buffer;
+    BIO_get_mem_ptr(b64, &buffer);
+    std::string result(buffer->data, buffer->length);
+    BIO_free_all(b64);
+    return result;
+}
+
+std::string streamHex(const std::vector<uint8_t>& data) {
+    std::ostringstream ss;
+    ss << std::hex << std::setfill('0');
+    for (const uint8_t byte : data) ss << std::setw(2) << static_cast<int>(byte);
+    return ss.str();
+}
+
+void report(const char* name, double oldSeconds, double newSeconds, size_t bytes) {
+    std::printf("%-14s old %8.1f MB/s  new %8.1f MB/s  (%.0fx)\n", name, bytes / oldSeconds / 1e6,
+                bytes / newSeconds / 1e6, oldSeconds / newSeconds);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const size_t iterations = LicenseChainTest::quickRun(argc, argv) ? 20 : 20000;
+    std::string data(4096, '\0');
+    for (size_t i = 0; i < data.size(); ++i) data[i] = static_cast<char>(i * 131 + 7);
+    const auto* bytes = reinterpret_cast<const uint8_t*>(data.data());
+    const size_t total = iterations * data.size();
+    size_t sink = 0;
+
+    std::string encoded(Utils::base64EncodedLength(data.size()), '\0');
+    CHECK(bioBase64Encode(data) == Utils::base64Encode(data));
+    const double bioEncode = LicenseChainTest::secondsFor([&] {
+        for (size_t i = 0; i < iterations; ++i) sink += bioBase64Encode(data).size();
+    });
+    const double bufferEncode = LicenseChainTest::secondsFor([&] {
+        for (size_t i = 0; i < iterations; ++i) sink += Utils::base64Encode(bytes, data.size(), &encoded[0]);
+    });
+    report("base64 encode", bioEncode, bufferEncode, total);
+
+    std::vector<uint8_t> decoded(Utils::base64DecodedMaxLength(encoded.size()));
+    const double evpDecode = LicenseChainTest::secondsFor([&] {
+        for (size_t i = 0; i < iterations; ++i) {
+            sink += EVP_DecodeBlock(decoded.data(), reinterpret_cast<const unsigned char*>(encoded.data()),
+                                    static_cast<int>(encoded.size()));
+        }
+    });
+    const double bufferDecode = LicenseChainTest::secondsFor([&] {
+        for (size_t i = 0; i < iterations; ++i) {
+            size_t length = 0;
+            CHECK(Utils::base64Decode(encoded, decoded.data(), length));
+            sink += length;
+        }
+    });
+    report("base64 decode", evpDecode, bufferDecode, total);
+
+    const std::vector<uint8_t> raw(data.begin(), data.end());
+    std::string hex(raw.size() * 2, '\0');
+    Utils::toHex(raw.data(), raw.size(), &hex[0]);
+    CHECK(streamHex(raw) == hex);
+    const double streamEncode = LicenseChainTest::secondsFor([&] {
+        for (size_t i = 0; i < iterations; ++i) sink += streamHex(raw).size();
+    });
+    const double tableEncode = LicenseChainTest::secondsFor([&] {
+        for (size_t i = 0; i < iterations; ++i) {
+            Utils::toHex(raw.data(), raw.size(), &hex[0]);
+            sink += static_cast<uint8_t>(hex[i % hex.size()]);
+        }
+    });
+    report("hex encode", streamEncode, tableEncode, total);
+
+    return sink == 0 ? 1 : TEST_RESULT;
+}
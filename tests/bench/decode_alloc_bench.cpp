@@ -0,0 +1,69 @@
+// Allocations and time to decode one 100-license page, into the std models
+// and into the pmr models backed by a per-response monotonic arena.
+
+#include "licensechain/model_decoder.h"
+#include "../fixtures.h"
+#include "../test_support.h"
+#include <atomic>
+#include <cstdlib>
+#include <memory_resource>
+#include <new>
+
+namespace {
+std::atomic<size_t> allocations{0};
+}
+
+void* operator new(std::size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+using namespace LicenseChain;
+
+int main(int argc, char** argv) {
+    const size_t iterations = LicenseChainTest::quickRun(argc, argv) ? 20 : 2000;
+    const std::string page = LicenseChainTest::licensePage(100);
+
+    size_t before = allocations.load();
+    ModelDecoder::decodeLicenseList(page);
+    const size_t stdAllocations = allocations.load() - before;
+
+    before = allocations.load();
+    {
+        std::pmr::monotonic_buffer_resource arena(256 * 1024);
+        const auto list = ModelDecoder::decodeLicenseList(page, &arena);
+        CHECK(list.data.size() == 100);
+    }
+    const size_t pmrAllocations = allocations.load() - before;
+
+    const double stdSeconds = LicenseChainTest::secondsFor([&] {
+        for (size_t i = 0; i < iterations; ++i) {
+            const auto list = ModelDecoder::decodeLicenseList(page);
+            CHECK(list.data.size() == 100);
+        }
+    });
+    // One arena per response, reusing its buffer as a request loop would.
+    std::vector<std::byte> buffer(256 * 1024);
+    const double pmrSeconds = LicenseChainTest::secondsFor([&] {
+        for (size_t i = 0; i < iterations; ++i) {
+            std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size());
+            const auto list = ModelDecoder::decodeLicenseList(page, &arena);
+            CHECK(list.data.size() == 100);
+        }
+    });
+
+    std::printf("100-license page, %zu bytes\n", page.size());
+    std::printf("  std models: %6zu allocations  %8.1f us/page\n", stdAllocations, stdSeconds * 1e6 / iterations);
+    std::printf("  pmr arena:  %6zu allocations  %8.1f us/page\n", pmrAllocations, pmrSeconds * 1e6 / iterations);
+    CHECK(pmrAllocations < stdAllocations / 10);
+    return TEST_RESULT;
+}
@@ -0,0 +1,47 @@
+// Webhook events dispatched per second through WebhookHandler::handleEvent,
+// for a built-in type (perfect hash) and a registered custom type. For scale,
+// a bare std::map<std::string, std::vector<std::function>> lookup and call;
+// handleEvent additionally checks for async dispatch and load shedding.
+
+#include "licensechain/webhook_handler.h"
+#include "../test_support.h"
+#include <functional>
+#include <map>
+
+using namespace LicenseChain;
+
+int main(int argc, char** argv) {
+    const size_t iterations = LicenseChainTest::quickRun(argc, argv) ? 10000 : 10000000;
+    size_t calls = 0;
+
+    WebhookHandler handler("whsec_bench");
+    handler.onEventView("license.revoked", [&](const WebhookEventView&) { ++calls; });
+    handler.onEventView("acme.sync", [&](const WebhookEventView&) { ++calls; });
+
+    std::map<std::string, std::vector<std::function<void(const WebhookEventView&)>>> map;
+    for (const char* type : {"license.created", "license.updated", "license.revoked", "license.expired",
+                             "user.created", "user.updated", "product.created", "product.updated",
+                             "webhook.created", "webhook.updated", "webhook.deleted", "acme.sync"}) {
+        map[type].push_back([&](const WebhookEventView&) { ++calls; });
+    }
+
+    WebhookEventView view;
+    auto rate = [&](const char* name, std::string_view type, auto&& dispatch) {
+        view.type = type;
+        const double seconds = LicenseChainTest::secondsFor([&] {
+            for (size_t i = 0; i < iterations; ++i) dispatch();
+        });
+        std::printf("%-24s %8.1f M events/s\n", name, iterations / seconds / 1e6);
+    };
+    rate("handleEvent, built-in", "license.revoked", [&] { handler.handleEvent(view); });
+    rate("handleEvent, custom", "acme.sync", [&] { handler.handleEvent(view); });
+    rate("bare std::map lookup", "license.revoked", [&] {
+        const auto it = map.find(std::string(view.type));
+        if (it != map.end()) {
+            for (const auto& callback : it->second) callback(view);
+        }
+    });
+
+    CHECK(calls == 3 * iterations);
+    return TEST_RESULT;
+}
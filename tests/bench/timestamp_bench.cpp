@@ -0,0 +1,63 @@
+// RFC 3339 parse and format against the stringstream/get_time/mktime code
+// they replaced.
+
+#include "licensechain/utils.h"
+#include "../test_support.h"
+#include <ctime>
+#include <iomanip>
+#include <sstream>
+
+using namespace LicenseChain;
+using std::chrono::system_clock;
+
+namespace {
+
+system_clock::time_point streamParse(const std::string& timestamp) {
+    std::tm tm = {};
+    std::istringstream ss(timestamp);
+    ss >> std::get_time(&tm, "%Y-%m-%dT%H:%M:%S");
+    return system_clock::from_time_t(std::mktime(&tm));
+}
+
+std::string streamFormat(system_clock::time_point timestamp) {
+    const std::time_t time = system_clock::to_time_t(timestamp);
+    std::ostringstream ss;
+    ss << std::put_time(std::gmtime(&time), "%Y-%m-%dT%H:%M:%SZ");
+    return ss.str();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const size_t iterations = LicenseChainTest::quickRun(argc, argv) ? 1000 : 1000000;
+    const std::string input = "2026-10-18T12:34:56.789Z";
+    int64_t sink = 0;
+
+    const double oldParse = LicenseChainTest::secondsFor([&] {
+        for (size_t i = 0; i < iterations; ++i) sink += streamParse(input).time_since_epoch().count();
+    });
+    const double newParse = LicenseChainTest::secondsFor([&] {
+        system_clock::time_point t;
+        for (size_t i = 0; i < iterations; ++i) {
+            CHECK(Utils::tryParseTimestamp(input, t));
+            sink += t.time_since_epoch().count();
+        }
+    });
+
+    system_clock::time_point now = system_clock::now();
+    const double oldFormat = LicenseChainTest::secondsFor([&] {
+        for (size_t i = 0; i < iterations; ++i) sink += static_cast<int64_t>(streamFormat(now).size());
+    });
+    const double newFormat = LicenseChainTest::secondsFor([&] {
+        char buffer[Utils::TIMESTAMP_BUFFER_SIZE];
+        for (size_t i = 0; i < iterations; ++i) {
+            sink += Utils::formatTimestamp(buffer, buffer + sizeof(buffer), now).ptr - buffer;
+        }
+    });
+
+    std::printf("parse:  stringstream %7.1f ns  tryParseTimestamp %6.1f ns  (%.0fx)\n",
+                oldParse * 1e9 / iterations, newParse * 1e9 / iterations, oldParse / newParse);
+    std::printf("format: stringstream %7.1f ns  to_chars buffer   %6.1f ns  (%.0fx)\n",
+                oldFormat * 1e9 / iterations, newFormat * 1e9 / iterations, oldFormat / newFormat);
+    return sink == 0 ? 1 : TEST_RESULT;
+}
@@ -0,0 +1,151 @@
+#include "licensechain/cancellation.h"
+#include "licensechain/exceptions.h"
+#include "test_support.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <thread>
+
+namespace {
+std::atomic<long> live_allocations{0};
+}
+
+void* operator new(std::size_t size) {
+    live_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    if (!p) return;
+    live_allocations.fetch_sub(1, std::memory_order_relaxed);
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    operator delete(p);
+}
+
+using namespace LicenseChain;
+using std::chrono::milliseconds;
+using Clock = CancellationToken::Clock;
+
+namespace {
+
+template <typename Exception>
+bool errorIs(const CancellationToken& token) {
+    try {
+        token.throwIfCancelled();
+    } catch (const Exception&) {
+        return true;
+    } catch (...) {
+    }
+    return false;
+}
+
+void testLinkedChildren() {
+    CancellationSource parent;
+    CancellationSource child(parent.token());
+    CancellationSource grandchild(child.token());
+    CancellationSource sibling(parent.token());
+    int fired = 0;
+    grandchild.token().onCancel([&] { ++fired; });
+
+    // Cancelling a child leaves its parent and siblings alone.
+    sibling.cancel();
+    CHECK(!parent.isCancelled());
+    CHECK(!child.isCancelled());
+
+    parent.cancel();
+    CHECK(child.isCancelled());
+    CHECK(grandchild.isCancelled());
+    CHECK(fired == 1);
+    CHECK(errorIs<CancelledException>(grandchild.token()));
+    // A child created from a cancelled parent starts out cancelled.
+    CancellationSource late(parent.token());
+    CHECK(late.isCancelled());
+}
+
+void testInheritedDeadline() {
+    const auto soon = Clock::now() + milliseconds(30);
+    CancellationSource parent(soon);
+    CancellationSource child(parent.token());
+    CancellationSource earlier(parent.token(), soon - milliseconds(10));
+    CHECK(child.token().deadline() == soon);
+    CHECK(earlier.token().deadline() == soon - milliseconds(10));
+    CHECK(child.token().remaining() <= milliseconds(30));
+    CHECK(!CancellationToken().hasDeadline());
+    CHECK(CancellationToken().remaining() == Clock::duration::max());
+
+    std::this_thread::sleep_for(milliseconds(40));
+    // Noticed by polling, without a timer.
+    CHECK(child.isCancelled());
+    CHECK(errorIs<DeadlineExceededException>(child.token()));
+
+    // With a timer, the parent's deadline fires the child's callbacks and
+    // keeps its reason.
+    TimerWheel timers(milliseconds(1));
+    CancellationSource timed;
+    CancellationSource linked(timed.token());
+    std::atomic<bool> fired{false};
+    linked.token().onCancel([&] { fired = true; });
+    timed.cancelAfter(timers, milliseconds(10));
+    const auto giveUp = Clock::now() + std::chrono::seconds(2);
+    while (!fired && Clock::now() < giveUp) std::this_thread::sleep_for(milliseconds(1));
+    CHECK(fired);
+    CHECK(errorIs<DeadlineExceededException>(linked.token()));
+}
+
+void testOnCancelInline() {
+    CancellationSource source;
+    source.cancel();
+    bool ran = false;
+    CHECK(source.token().onCancel([&] { ran = true; }) == 0);
+    CHECK(ran);
+
+    // A default token can never be cancelled, so the callback never runs.
+    bool never = false;
+    CHECK(CancellationToken().onCancel([&] { never = true; }) == 0);
+    CHECK(!never);
+
+    CancellationSource pending;
+    int count = 0;
+    const uint64_t removed = pending.token().onCancel([&] { count += 10; });
+    pending.token().onCancel([&] { ++count; });
+    pending.token().removeCallback(removed);
+    pending.cancel();
+    pending.cancel();
+    CHECK(count == 1);
+}
+
+void testChildReleasesParentCallback() {
+    CancellationSource parent;
+    // Warm up the parent's callback vector so its capacity is not counted.
+    for (int i = 0; i < 4; ++i) CancellationSource(parent.token());
+    const long before = live_allocations.load();
+    for (int i = 0; i < 1000; ++i) {
+        CancellationSource child(parent.token());
+        CHECK(!child.isCancelled());
+    }
+    // Each child removed its callback from the parent when it went away.
+    CHECK(live_allocations.load() - before < 10);
+
+    // A child's deadline timer is dropped with it.
+    TimerWheel timers;
+    {
+        CancellationSource child(parent.token());
+        child.cancelAfter(timers, std::chrono::seconds(60));
+        CHECK(timers.pending() == 1);
+    }
+    CHECK(timers.pending() == 0);
+}
+
+} // namespace
+
+int main() {
+    testLinkedChildren();
+    testInheritedDeadline();
+    testOnCancelInline();
+    testChildReleasesParentCallback();
+    return TEST_RESULT;
+}
@@ -0,0 +1,200 @@
+#include "licensechain/circuit_breaker.h"
+#include "licensechain/response_cache.h"
+#include "test_support.h"
+#include <string>
+#include <thread>
+
+using namespace LicenseChain;
+using std::chrono::milliseconds;
+
+namespace {
+
+CircuitBreakerOptions quickOptions() {
+    CircuitBreakerOptions options;
+    options.minimum_requests = 4;
+    options.open_duration = milliseconds(50);
+    options.half_open_probes = 2;
+    return options;
+}
+
+template <typename Exception>
+void recordError(CircuitBreaker& breaker) {
+    breaker.record(std::make_exception_ptr(Exception("error")));
+}
+
+void openBreaker(CircuitBreaker& breaker) {
+    for (int i = 0; i < 4; ++i) recordError<NetworkException>(breaker);
+}
+
+void testOpensAtThreshold() {
+    CircuitBreaker breaker(quickOptions());
+    // Nothing opens before minimum_requests, whatever the rate.
+    recordError<ServerException>(breaker);
+    breaker.recordSuccess();
+    breaker.recordSuccess();
+    CHECK(breaker.state() == CircuitState::Closed);
+    recordError<ServerException>(breaker);
+    CHECK(breaker.state() == CircuitState::Open);
+    CHECK(breaker.metrics().opened == 1);
+
+    CHECK(!breaker.allowRequest());
+    bool threw = false;
+    try {
+        breaker.execute([] { return 1; });
+    } catch (const CircuitOpenException&) {
+        threw = true;
+    }
+    CHECK(threw);
+    CHECK(breaker.execute([] { return 1; }, [] { return 2; }) == 2);
+    CHECK(breaker.metrics().short_circuited == 3);
+}
+
+void testStaysClosedBelowRate() {
+    CircuitBreaker breaker(quickOptions());
+    for (int i = 0; i < 10; ++i) {
+        breaker.recordSuccess();
+        breaker.recordSuccess();
+        recordError<NetworkException>(breaker);
+    }
+    CHECK(breaker.state() == CircuitState::Closed);
+    // Errors that show the endpoint is up count as successes.
+    for (int i = 0; i < 10; ++i) {
+        recordError<ValidationException>(breaker);
+        recordError<NotFoundException>(breaker);
+        recordError<RateLimitException>(breaker);
+    }
+    const auto metrics = breaker.metrics();
+    CHECK(metrics.state == CircuitState::Closed);
+    CHECK(metrics.successes == 50);
+    CHECK(metrics.failures == 10);
+}
+
+void testHalfOpenProbeLimit() {
+    CircuitBreaker breaker(quickOptions());
+    openBreaker(breaker);
+    std::this_thread::sleep_for(milliseconds(60));
+    CHECK(breaker.allowRequest());
+    CHECK(breaker.state() == CircuitState::HalfOpen);
+    CHECK(breaker.allowRequest());
+    // Both probes are out; everything else waits for their outcome.
+    CHECK(!breaker.allowRequest());
+    breaker.recordSuccess();
+    CHECK(breaker.state() == CircuitState::HalfOpen);
+    CHECK(!breaker.allowRequest());
+    breaker.recordSuccess();
+    CHECK(breaker.state() == CircuitState::Closed);
+    // The window starts afresh, so the old failures cannot reopen it.
+    CHECK(breaker.metrics().failures == 0);
+    CHECK(breaker.allowRequest());
+}
+
+void testFailedProbeReopens() {
+    CircuitBreaker breaker(quickOptions());
+    openBreaker(breaker);
+    std::this_thread::sleep_for(milliseconds(60));
+    CHECK(breaker.allowRequest());
+    breaker.recordFailure();
+    CHECK(breaker.state() == CircuitState::Open);
+    CHECK(breaker.metrics().opened == 2);
+    CHECK(!breaker.allowRequest());
+}
+
+void testDeadlineCountsAsFailure() {
+    CircuitBreaker breaker(quickOptions());
+    for (int i = 0; i < 10; ++i) {
+        try {
+            breaker.execute([]() -> int { throw DeadlineExceededException("Deadline exceeded"); });
+        } catch (const LicenseChainException&) {
+        }
+    }
+    const auto metrics = breaker.metrics();
+    CHECK(metrics.state == CircuitState::Open);
+    CHECK(metrics.failures == 4);
+    CHECK(metrics.short_circuited == 6);
+}
+
+void testCancelledNotCounted() {
+    CircuitBreaker breaker(quickOptions());
+    recordError<CancelledException>(breaker);
+    CHECK(breaker.metrics().successes == 0);
+    CHECK(breaker.metrics().failures == 0);
+
+    // Cancelled probes neither close the circuit nor use up the probe limit.
+    openBreaker(breaker);
+    std::this_thread::sleep_for(milliseconds(60));
+    for (int i = 0; i < 5; ++i) {
+        bool cancelled = false;
+        try {
+            breaker.execute([]() -> int { throw CancelledException("Operation was cancelled"); });
+        } catch (const CancelledException&) {
+            cancelled = true;
+        }
+        CHECK(cancelled);
+    }
+    CHECK(breaker.state() == CircuitState::HalfOpen);
+    CHECK(breaker.execute([] { return 1; }) == 1);
+    CHECK(breaker.execute([] { return 1; }) == 1);
+    CHECK(breaker.state() == CircuitState::Closed);
+}
+
+void testRejectsBadThreshold() {
+    CircuitBreakerOptions options;
+    options.failure_rate_threshold = 0;
+    bool threw = false;
+    try {
+        CircuitBreakerRegistry registry(options);
+    } catch (const ConfigurationException&) {
+        threw = true;
+    }
+    CHECK(threw);
+}
+
+void testCacheStaleExpiry() {
+    ResponseCache<std::string> cache(10, milliseconds(50), milliseconds(300));
+    cache.put("a", "1");
+    CHECK(cache.get("a") == std::string("1"));
+    std::this_thread::sleep_for(milliseconds(100));
+    // Too old to be fresh, still good enough as a fallback.
+    CHECK(!cache.get("a"));
+    CHECK(cache.getStale("a") == std::string("1"));
+    std::this_thread::sleep_for(milliseconds(300));
+    CHECK(!cache.getStale("a"));
+    // Storing again refreshes the entry.
+    cache.put("a", "2");
+    CHECK(cache.get("a") == std::string("2"));
+}
+
+void testCacheEvictsLeastRecentlyUsed() {
+    ResponseCache<std::string> cache(2);
+    cache.put("a", "1");
+    cache.put("b", "2");
+    CHECK(cache.get("a"));
+    cache.put("c", "3");
+    CHECK(cache.size() == 2);
+    CHECK(cache.get("a"));
+    CHECK(!cache.get("b"));
+    CHECK(cache.get("c"));
+    // Updating an entry also counts as a use.
+    cache.put("a", "4");
+    cache.put("d", "5");
+    CHECK(cache.get("a") == std::string("4"));
+    CHECK(!cache.get("c"));
+    CHECK(cache.erase("a"));
+    CHECK(!cache.erase("a"));
+    CHECK(cache.size() == 1);
+}
+
+} // namespace
+
+int main() {
+    testOpensAtThreshold();
+    testStaysClosedBelowRate();
+    testHalfOpenProbeLimit();
+    testFailedProbeReopens();
+    testDeadlineCountsAsFailure();
+    testCancelledNotCounted();
+    testRejectsBadThreshold();
+    testCacheStaleExpiry();
+    testCacheEvictsLeastRecentlyUsed();
+    return TEST_RESULT;
+}
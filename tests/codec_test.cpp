@@ -0,0 +1,100 @@
+#include "licensechain/utils.h"
+#include "test_support.h"
+#include <vector>
+
+using namespace LicenseChain;
+
+namespace {
+
+
+std::string encode(const std::string& data, bool url) {
+    std::string out(Utils::base64EncodedLength(data.size(), !url), '\0');
+    const auto* bytes = reinterpret_cast<const uint8_t*>(data.data());
+    const size_t n = url ? Utils::base64UrlEncode(bytes, data.size(), &out[0])
+                         : Utils::base64Encode(bytes, data.size(), &out[0]);
+    out.resize(n);
+    return out;
+}
+
+bool decode(const std::string& text, bool url, std::string& out) {
+    out.assign(Utils::base64DecodedMaxLength(text.size()), '\0');
+    size_t length = 0;
+    auto* bytes = reinterpret_cast<uint8_t*>(&out[0]);
+    const bool ok = url ? Utils::base64UrlDecode(text, bytes, length) : Utils::base64Decode(text, bytes, length);
+    out.resize(ok ? length : 0);
+    return ok;
+}
+
+void testBase64Vectors() {
+    // RFC 4648, section 10.
+    const char* vectors[][2] = {
+        {"", ""}, {"f", "Zg=="}, {"fo", "Zm8="}, {"foo", "Zm9v"},
+        {"foob", "Zm9vYg=="}, {"fooba", "Zm9vYmE="}, {"foobar", "Zm9vYmFy"},
+    };
+    for (const auto& v : vectors) {
+        CHECK(Utils::base64Encode(std::string(v[0])) == v[1]);
+        CHECK(Utils::base64Decode(std::string(v[1])) == v[0]);
+        std::string unpadded(v[1]);
+        unpadded.erase(unpadded.find_last_not_of('=') + 1);
+        CHECK(encode(v[0], true) == unpadded);
+        std::string decoded;
+        CHECK(decode(unpadded, false, decoded) && decoded == v[0]);
+    }
+    CHECK(encode("\xfb\xff", false) == "+/8=");
+    CHECK(encode("\xfb\xff", true) == "-_8");
+}
+
+void testBase64RoundTrip() {
+    // Lengths around the vector block sizes, so the SIMD and tail paths both run.
+    std::mt19937 random(42);
+    for (size_t length = 0; length <= 300; ++length) {
+        std::string data(length, '\0');
+        for (auto& c : data) c = static_cast<char>(random());
+        for (const bool url : {false, true}) {
+            const std::string text = encode(data, url);
+            CHECK(text.size() == Utils::base64EncodedLength(length, !url));
+            std::string decoded;
+            CHECK(decode(text, url, decoded));
+            CHECK(decoded == data);
+        }
+    }
+}
+
+void testBase64Rejects() {
+    std::string out;
+    CHECK(!decode("Zm9v!mFy", false, out));
+    CHECK(!decode("Zm9vYmFy-_", false, out));
+    CHECK(!decode("Zm9vYmFy+/", true, out));
+    CHECK(!decode("Z", false, out));
+    CHECK(!decode("Zm=v", false, out));
+}
+
+void testHex() {
+    std::mt19937 random(7);
+    for (size_t length = 0; length <= 100; ++length) {
+        std::vector<uint8_t> data(length);
+        for (auto& b : data) b = static_cast<uint8_t>(random());
+        std::string hex(length * 2, '\0');
+        Utils::toHex(data.data(), length, &hex[0]);
+        std::vector<uint8_t> back(length);
+        CHECK(Utils::fromHex(hex, back.data()));
+        CHECK(back == data);
+    }
+    const uint8_t bytes[] = {0x00, 0x7f, 0xab, 0xff};
+    char hex[8];
+    Utils::toHex(bytes, 4, hex);
+    CHECK(std::string(hex, 8) == "007fabff");
+    uint8_t out[4];
+    CHECK(!Utils::fromHex("0g", out));
+    CHECK(!Utils::fromHex("abc", out));
+}
+
+} // namespace
+
+int main() {
+    testBase64Vectors();
+    testBase64RoundTrip();
+    testBase64Rejects();
+    testHex();
+    return TEST_RESULT;
+}
@@ -0,0 +1,160 @@
+#include "licensechain/concurrency_limiter.h"
+#include "licensechain/exceptions.h"
+#include "test_support.h"
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace LicenseChain;
+using std::chrono::milliseconds;
+using Outcome = ConcurrencyLimiter::Outcome;
+
+namespace {
+
+ConcurrencyLimitOptions fixed(size_t limit) {
+    ConcurrencyLimitOptions options;
+    options.initial_limit = limit;
+    options.min_limit = limit;
+    options.max_limit = limit;
+    options.reserved_share = 0.25;
+    return options;
+}
+
+void testReservedForValidation() {
+    ConcurrencyLimiter limiter(fixed(4));
+    CHECK(limiter.metrics().reserved == 1);
+    std::vector<ConcurrencyLimiter::Permit> held;
+    for (int i = 0; i < 3; ++i) {
+        auto permit = limiter.tryAcquire(RequestPriority::Background);
+        CHECK(permit.has_value());
+        if (permit) held.push_back(std::move(*permit));
+    }
+    CHECK(!limiter.tryAcquire(RequestPriority::Interactive));
+    auto validation = limiter.tryAcquire(RequestPriority::Validation);
+    CHECK(validation.has_value());
+    CHECK(!limiter.tryAcquire(RequestPriority::Validation));
+    CHECK(limiter.metrics().in_flight == 4);
+}
+
+void testFreedSlotGoesToHighestPriority() {
+    ConcurrencyLimiter limiter(fixed(2));
+    auto a = limiter.tryAcquire(RequestPriority::Validation);
+    auto b = limiter.tryAcquire(RequestPriority::Validation);
+    CHECK(a && b);
+
+    std::mutex mutex;
+    std::vector<RequestPriority> order;
+    std::vector<std::thread> waiters;
+    for (const auto priority : {RequestPriority::Background, RequestPriority::Interactive}) {
+        waiters.emplace_back([&, priority] {
+            auto permit = limiter.acquire(milliseconds(5000), priority);
+            std::lock_guard<std::mutex> lock(mutex);
+            order.push_back(priority);
+        });
+        // Background waits first, so arrival order alone would favour it.
+        while (limiter.metrics().waiting[static_cast<size_t>(priority)] == 0) std::this_thread::yield();
+    }
+    // One non-Validation slot exists; it must go to Interactive.
+    a->release();
+    b->release();
+    for (auto& waiter : waiters) waiter.join();
+    CHECK(order.size() == 2 && order[0] == RequestPriority::Interactive);
+}
+
+void testAcquireTimesOut() {
+    ConcurrencyLimiter limiter(fixed(2));
+    auto a = limiter.tryAcquire(RequestPriority::Validation);
+    auto b = limiter.tryAcquire(RequestPriority::Validation);
+    const double waited = LicenseChainTest::secondsFor([&] {
+        CHECK(!limiter.acquire(milliseconds(50), RequestPriority::Validation));
+    });
+    CHECK(waited >= 0.045);
+    CHECK(limiter.metrics().rejected >= 1);
+}
+
+void testOutcomes() {
+    ConcurrencyLimitOptions options;
+    options.initial_limit = 20;
+    ConcurrencyLimiter limiter(options);
+    limiter.tryAcquire()->release(Outcome::Ignored);
+    CHECK(limiter.limit() == 20);
+    limiter.tryAcquire()->release(Outcome::Dropped);
+    CHECK(limiter.limit() < 20);
+    CHECK(limiter.metrics().dropped == 1);
+}
+
+void testGrowsUnderLoad() {
+    ConcurrencyLimitOptions options;
+    options.initial_limit = 4;
+    options.max_limit = 64;
+    ConcurrencyLimiter limiter(options);
+    // Keep the non-reserved slots busy with a steady RTT; the limit must grow.
+    std::atomic<bool> done{false};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 32; ++t) {
+        threads.emplace_back([&] {
+            while (!done.load()) {
+                if (auto permit = limiter.acquire(milliseconds(10))) {
+                    std::this_thread::sleep_for(milliseconds(1));
+                    permit->release();
+                }
+            }
+        });
+    }
+    std::this_thread::sleep_for(milliseconds(500));
+    done = true;
+    for (auto& thread : threads) thread.join();
+    CHECK(limiter.limit() > 4);
+}
+
+void testRecoversFromMinimum() {
+    // After an outage has cut the limit to its floor, Interactive traffic
+    // alone must be able to grow it again even though one slot is reserved.
+    ConcurrencyLimitOptions options;
+    options.initial_limit = 1;
+    options.max_limit = 64;
+    ConcurrencyLimiter limiter(options);
+    std::atomic<int> remaining{800};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 16; ++t) {
+        threads.emplace_back([&] {
+            while (remaining.fetch_sub(1) > 0) {
+                while (true) {
+                    auto permit = limiter.acquire(milliseconds(100), RequestPriority::Interactive);
+                    if (!permit) continue;
+                    std::this_thread::sleep_for(milliseconds(1));
+                    permit->release();
+                    break;
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    CHECK(limiter.limit() >= 6);
+}
+
+void testRejectsBadOptions() {
+    ConcurrencyLimitOptions options;
+    options.reserved_share = 1.0;
+    bool threw = false;
+    try {
+        ConcurrencyLimiter limiter(options);
+    } catch (const ConfigurationException&) {
+        threw = true;
+    }
+    CHECK(threw);
+}
+
+} // namespace
+
+int main() {
+    testReservedForValidation();
+    testFreedSlotGoesToHighestPriority();
+    testAcquireTimesOut();
+    testOutcomes();
+    testGrowsUnderLoad();
+    testRecoversFromMinimum();
+    testRejectsBadOptions();
+    return TEST_RESULT;
+}
@@ -0,0 +1,129 @@
+#include "licensechain/executor.h"
+#include "test_support.h"
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <stdexcept>
+#include <vector>
+
+using namespace LicenseChain;
+using std::chrono::milliseconds;
+
+namespace {
+
+// Occupies the executor's only worker until open() is called.
+class Gate {
+public:
+    explicit Gate(Executor& executor) : opened_(promise_.get_future().share()) {
+        std::promise<void> started;
+        auto running = started.get_future();
+        executor.post(0, [this, &started] {
+            started.set_value();
+            opened_.wait();
+        });
+        running.wait();
+    }
+    void open() { promise_.set_value(); }
+
+private:
+    std::promise<void> promise_;
+    std::shared_future<void> opened_;
+};
+
+void testKeyedOrder() {
+    Executor executor(4);
+    std::mutex mutex;
+    std::vector<int> seen[4];
+    for (int i = 0; i < 1000; ++i) {
+        const uint64_t key = static_cast<uint64_t>(i % 4);
+        executor.post(key, [&, key, i] {
+            std::lock_guard<std::mutex> lock(mutex);
+            seen[key].push_back(i);
+        });
+    }
+    executor.shutdown();
+    for (const auto& values : seen) {
+        CHECK(values.size() == 250);
+        CHECK(std::is_sorted(values.begin(), values.end()));
+    }
+}
+
+void testPriorityOrder() {
+    Executor executor(1);
+    Gate gate(executor);
+    std::vector<RequestPriority> order;
+    for (const auto priority : {RequestPriority::Background, RequestPriority::Interactive, RequestPriority::Validation}) {
+        executor.post(0, [&order, priority] { order.push_back(priority); }, priority);
+    }
+    gate.open();
+    executor.shutdown();
+    CHECK(order.size() == 3 && order[0] == RequestPriority::Validation && order[1] == RequestPriority::Interactive &&
+          order[2] == RequestPriority::Background);
+}
+
+void testReservedQueueDepth() {
+    Executor executor(1, 4, 1);
+    Gate gate(executor);
+    for (int i = 0; i < 3; ++i) CHECK(executor.tryPost([] {}, RequestPriority::Background));
+    // The last place is kept for validation.
+    CHECK(!executor.tryPost([] {}, RequestPriority::Interactive));
+    CHECK(executor.tryPost([] {}, RequestPriority::Validation));
+    CHECK(!executor.tryPost([] {}, RequestPriority::Validation));
+    CHECK(executor.metrics().rejected == 2);
+    gate.open();
+}
+
+void testValidationNotBehindExports() {
+    // Every worker is busy with slow exports; reserved threads still run validation at once.
+    Executor executor(2, 0, 0, 1);
+    for (int i = 0; i < 16; ++i) {
+        executor.post([] { std::this_thread::sleep_for(milliseconds(200)); }, RequestPriority::Background);
+    }
+    std::this_thread::sleep_for(milliseconds(20));
+    const auto posted = std::chrono::steady_clock::now();
+    std::promise<std::chrono::steady_clock::time_point> ran;
+    executor.post([&ran] { ran.set_value(std::chrono::steady_clock::now()); }, RequestPriority::Validation);
+    const auto waited = ran.get_future().get() - posted;
+    CHECK(waited < milliseconds(50));
+    CHECK(executor.threadCount() == 3);
+}
+
+void testExceptionsCounted() {
+    Executor executor(2);
+    executor.post([] { throw std::runtime_error("task"); });
+    executor.post([] {});
+    executor.shutdown();
+    const auto metrics = executor.metrics();
+    CHECK(metrics.failed == 1 && metrics.completed == 1 && metrics.queue_length == 0);
+    CHECK(!executor.tryPost([] {}));
+}
+
+void testShutdownLosesNothing() {
+    // Every task tryPost() accepts must run, even when shutdown() races it.
+    for (int round = 0; round < 2000; ++round) {
+        Executor executor(4);
+        std::atomic<int> accepted{0}, ran{0};
+        std::thread poster([&] {
+            while (executor.tryPost([&ran] { ran.fetch_add(1); })) accepted.fetch_add(1);
+        });
+        while (accepted.load() < 10) std::this_thread::yield();
+        executor.shutdown();
+        poster.join();
+        CHECK(ran == accepted);
+        if (ran != accepted) return;
+    }
+}
+
+} // namespace
+
+int main() {
+    testKeyedOrder();
+    testPriorityOrder();
+    testReservedQueueDepth();
+    testValidationNotBehindExports();
+    testExceptionsCounted();
+    testShutdownLosesNothing();
+    return TEST_RESULT;
+}
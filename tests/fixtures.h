@@ -0,0 +1,24 @@
+#pragma once
+
+#include <string>
+
+namespace LicenseChainTest {
+
+// One page of GET /licenses, as the API returns it.
+inline std::string licensePage(size_t count) {
+    std::string json = "{\"data\":[";
+    for (size_t i = 0; i < count; ++i) {
+        const std::string n = std::to_string(i);
+        if (i) json += ',';
+        json += "{\"id\":\"lic_" + n + "\",\"user_id\":\"user_" + n + "\",\"product_id\":\"prod_42\","
+                "\"license_key\":\"LC-" + std::string(27 - n.size(), '0') + n + "\",\"status\":\"active\","
+                "\"created_at\":\"2026-01-02T03:04:05.678Z\",\"updated_at\":\"2026-10-18T12:34:56+00:00\","
+                "\"expires_at\":" + (i % 3 ? "\"2027-01-02T03:04:05Z\"" : "null") + ","
+                "\"metadata\":{\"seat\":\"" + n + "\",\"plan\":\"enterprise\",\"region\":\"eu-west-1\"},"
+                "\"features\":[\"sso\",\"audit\"]}";
+    }
+    json += "],\"total\":" + std::to_string(count * 10) + ",\"page\":2,\"limit\":" + std::to_string(count) + "}";
+    return json;
+}
+
+} // namespace LicenseChainTest
@@ -0,0 +1,136 @@
+#include "licensechain/hedging.h"
+#include "test_support.h"
+#include <atomic>
+#include <string>
+#include <thread>
+
+using namespace LicenseChain;
+using std::chrono::milliseconds;
+
+namespace {
+
+HedgingPolicy quickHedge() {
+    HedgingPolicy policy;
+    policy.initial_delay = milliseconds(10);
+    return policy;
+}
+
+void testFirstSuccessWins() {
+    Executor executor(4);
+    TimerWheel timers(milliseconds(1));
+    RequestHedger hedger(executor, timers, quickHedge(), std::make_shared<RetryBudget>(0.0, 1.0));
+    std::atomic<int> attempts{0};
+    std::atomic<bool> loserCancelled{false};
+    auto future = hedger.submit([&](const CancellationToken& token) {
+        if (attempts.fetch_add(1) > 0) return std::string("hedge");
+        // The primary stalls until the hedge's success cancels it.
+        const auto giveUp = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (!token.isCancelled() && std::chrono::steady_clock::now() < giveUp) {
+            std::this_thread::sleep_for(milliseconds(1));
+        }
+        loserCancelled = token.isCancelled();
+        return std::string("primary");
+    });
+    CHECK(future.get() == "hedge");
+    executor.shutdown();
+    CHECK(attempts == 2);
+    CHECK(loserCancelled);
+    const auto stats = hedger.stats();
+    CHECK(stats.calls == 1);
+    CHECK(stats.hedges == 1);
+    CHECK(stats.hedge_wins == 1);
+}
+
+void testBudgetExhausted() {
+    Executor executor(4);
+    TimerWheel timers(milliseconds(1));
+    auto budget = std::make_shared<RetryBudget>(0.0, 1.0);
+    CHECK(budget->tryWithdraw());
+    RequestHedger hedger(executor, timers, quickHedge(), budget);
+    std::atomic<int> attempts{0};
+    auto future = hedger.submit([&] {
+        attempts.fetch_add(1);
+        std::this_thread::sleep_for(milliseconds(50));
+        return 7;
+    });
+    CHECK(future.get() == 7);
+    CHECK(attempts == 1);
+    const auto stats = hedger.stats();
+    CHECK(stats.hedges == 0);
+    CHECK(stats.budget_exhausted == 1);
+}
+
+void testAllAttemptsFail() {
+    Executor executor(4);
+    TimerWheel timers(milliseconds(1));
+    RequestHedger hedger(executor, timers, quickHedge(), std::make_shared<RetryBudget>(0.0, 1.0));
+    std::atomic<int> attempts{0};
+    auto future = hedger.submit([&]() -> int {
+        if (attempts.fetch_add(1) == 0) std::this_thread::sleep_for(milliseconds(50));
+        throw NetworkException("unreachable");
+    });
+    bool threw = false;
+    try {
+        future.get();
+    } catch (const NetworkException&) {
+        threw = true;
+    }
+    CHECK(threw);
+    CHECK(attempts == 2);
+}
+
+void testExecutorShutDown() {
+    Executor executor(1);
+    TimerWheel timers(milliseconds(1));
+    RequestHedger hedger(executor, timers, quickHedge());
+    executor.shutdown();
+    auto future = hedger.submit([] { return 1; });
+    bool threw = false;
+    try {
+        future.get();
+    } catch (const LicenseChainException& e) {
+        threw = e.getErrorCode() == "EXECUTOR_SHUTDOWN";
+    }
+    CHECK(threw);
+}
+
+void testPercentile() {
+    LatencyTracker tracker;
+    for (int i = 0; i < 19; ++i) tracker.record(milliseconds(1));
+    // Too few samples for an estimate.
+    CHECK(tracker.percentile(0.5).count() == 0);
+    for (int i = 0; i < 71; ++i) tracker.record(milliseconds(1));
+    for (int i = 0; i < 10; ++i) tracker.record(milliseconds(100));
+    CHECK(tracker.count() == 100);
+    // Buckets grow by a quarter, so the bound is within 25% above the sample.
+    const auto median = tracker.percentile(0.5);
+    CHECK(median >= milliseconds(1) && median < std::chrono::microseconds(1250));
+    const auto tail = tracker.percentile(0.95);
+    CHECK(tail >= milliseconds(100) && tail < milliseconds(125));
+    CHECK(tracker.percentile(0.9) == median);
+}
+
+void testPercentileDecays() {
+    LatencyTracker tracker(100);
+    for (int i = 0; i < 99; ++i) tracker.record(milliseconds(100));
+    CHECK(tracker.count() == 99);
+    // The hundredth sample halves every bucket.
+    tracker.record(milliseconds(100));
+    CHECK(tracker.count() == 50);
+    for (int i = 0; i < 99; ++i) tracker.record(milliseconds(1));
+    tracker.record(milliseconds(1));
+    // Old samples now weigh a quarter: the median has followed the new latency.
+    CHECK(tracker.percentile(0.5) < milliseconds(2));
+}
+
+} // namespace
+
+int main() {
+    testFirstSuccessWins();
+    testBudgetExhausted();
+    testAllAttemptsFail();
+    testExecutorShutDown();
+    testPercentile();
+    testPercentileDecays();
+    return TEST_RESULT;
+}
@@ -0,0 +1,79 @@
+#include "licensechain/model_decoder.h"
+#include "licensechain/exceptions.h"
+#include "licensechain/utils.h"
+#include "fixtures.h"
+#include "test_support.h"
+#include <memory_resource>
+
+using namespace LicenseChain;
+
+namespace {
+
+void testLicense() {
+    const License license = ModelDecoder::decodeLicense(
+        R"({"id":"lic_1","user_id":"user_1","product_id":"prod_1","license_key":"LC-ABC",)"
+        R"("status":"active","created_at":"2026-10-18T12:34:56.789Z","updated_at":"2026-10-18T14:34:56+02:00",)"
+        R"("expires_at":null,"metadata":{"seat":"7","nested":{"ignored":true}},"unknown":[1,2,{"a":"b"}]})");
+    CHECK(license.id == "lic_1");
+    CHECK(license.user_id == "user_1");
+    CHECK(license.license_key == "LC-ABC");
+    CHECK(license.status == "active");
+    CHECK(Utils::formatTimestamp(license.created_at) == "2026-10-18T12:34:56.789Z");
+    CHECK(Utils::formatTimestamp(license.updated_at) == "2026-10-18T12:34:56.000Z");
+    CHECK(!license.expires_at);
+    CHECK(license.metadata.size() == 1 && license.metadata.at("seat") == "7");
+}
+
+void testLicenseList() {
+    const std::string page = LicenseChainTest::licensePage(100);
+    const LicenseListResponse list = ModelDecoder::decodeLicenseList(page);
+    CHECK(list.data.size() == 100);
+    CHECK(list.total == 1000 && list.page == 2 && list.limit == 100);
+    CHECK(list.data[37].id == "lic_37");
+    CHECK(list.data[37].metadata.at("seat") == "37");
+    CHECK(list.data[3].expires_at.has_value() == false);
+    CHECK(list.data[4].expires_at.has_value());
+}
+
+void testPmrMatches() {
+    const std::string page = LicenseChainTest::licensePage(100);
+    const LicenseListResponse expected = ModelDecoder::decodeLicenseList(page);
+
+    // Nothing may come from the default resource while decoding.
+    std::pmr::monotonic_buffer_resource pool(1 << 20);
+    std::pmr::memory_resource* previous = std::pmr::set_default_resource(std::pmr::null_memory_resource());
+    const pmr::LicenseListResponse decoded = ModelDecoder::decodeLicenseList(page, &pool);
+    std::pmr::set_default_resource(previous);
+    CHECK(decoded.data.size() == expected.data.size());
+    CHECK(decoded.total == expected.total);
+    for (size_t i = 0; i < decoded.data.size() && i < expected.data.size(); ++i) {
+        const auto& a = decoded.data[i];
+        const auto& b = expected.data[i];
+        CHECK(a.id == b.id.c_str() && a.license_key == b.license_key.c_str() && a.status == b.status.c_str());
+        CHECK(a.created_at == b.created_at && a.updated_at == b.updated_at && a.expires_at == b.expires_at);
+        CHECK(a.metadata.size() == b.metadata.size());
+        CHECK(a.get_allocator().resource() == &pool);
+    }
+}
+
+void testMalformed() {
+    for (const char* bad : {"", "{", "{\"data\":[", "[1,2", "{\"id\":}"}) {
+        bool threw = false;
+        try {
+            ModelDecoder::decodeLicenseList(bad);
+        } catch (const LicenseChainException& e) {
+            threw = e.getErrorCode() == "DECODE_ERROR";
+        }
+        CHECK(threw);
+    }
+}
+
+} // namespace
+
+int main() {
+    testLicense();
+    testLicenseList();
+    testPmrMatches();
+    testMalformed();
+    return TEST_RESULT;
+}
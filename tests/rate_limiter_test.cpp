@@ -0,0 +1,101 @@
+#include "licensechain/rate_limiter.h"
+#include "licensechain/exceptions.h"
+#include "test_support.h"
+
+using namespace LicenseChain;
+using std::chrono::milliseconds;
+
+namespace {
+
+constexpr EndpointClass CLS = EndpointClass::Validation;
+
+void testBurstThenFailFast() {
+    AdaptiveRateLimiter limiter;
+    limiter.setLimit(CLS, {10.0, 5.0});
+    for (int i = 0; i < 5; ++i) CHECK(limiter.tryAcquire(CLS));
+    CHECK(!limiter.tryAcquire(CLS));
+    bool threw = false;
+    try {
+        limiter.acquireOrThrow(CLS);
+    } catch (const RateLimitException&) {
+        threw = true;
+    }
+    CHECK(threw);
+    // The next token is 100 ms away.
+    CHECK(!limiter.acquire(CLS, milliseconds(20)));
+    CHECK(limiter.acquire(CLS, milliseconds(300)));
+    const auto stats = limiter.stats(CLS);
+    CHECK(stats.granted == 6);
+    CHECK(stats.delayed == 1);
+}
+
+void testReserveSchedules() {
+    AdaptiveRateLimiter limiter;
+    limiter.setLimit(CLS, {100.0, 1.0});
+    const auto now = limiter.reserve(CLS, milliseconds(0));
+    CHECK(now && *now == AdaptiveRateLimiter::Clock::duration::zero());
+    const auto later = limiter.reserve(CLS, milliseconds(50));
+    CHECK(later && *later > milliseconds(5) && *later <= milliseconds(10));
+    CHECK(!limiter.reserve(CLS, milliseconds(1)));
+}
+
+void testRetryAfterBlocks() {
+    AdaptiveRateLimiter limiter;
+    limiter.setLimit(CLS, {100.0, 100.0});
+    limiter.onResponse(CLS, 429, {{"retry-after", "1"}});
+    CHECK(!limiter.tryAcquire(CLS));
+    CHECK(limiter.stats(CLS).rate_limited == 1);
+    // Other classes are not affected.
+    CHECK(limiter.tryAcquire(EndpointClass::Analytics));
+}
+
+void testBackoffWithoutHeaders() {
+    AdaptiveRateLimiter limiter;
+    limiter.setLimit(CLS, {50.0, 50.0});
+    limiter.onResponse(CLS, 429, {});
+    CHECK(limiter.stats(CLS).rate < 50.0 * 0.81);
+    limiter.onResponse(CLS, 200, {});
+    CHECK(limiter.stats(CLS).rate <= 50.0);
+}
+
+void testFollowsServerQuota() {
+    AdaptiveRateLimiter limiter;
+    limiter.setLimit(CLS, {1000.0, 1.0});
+    limiter.onResponse(CLS, 200, {{"X-RateLimit-Remaining", "10"}, {"X-RateLimit-Reset", "10"}});
+    const auto stats = limiter.stats(CLS);
+    CHECK(stats.server_paced);
+    // Ten requests over ten seconds, not the configured thousand per second.
+    CHECK(stats.rate > 0.5 && stats.rate < 2.0);
+}
+
+void testRejectsAbsurdHeaders() {
+    const auto day = std::chrono::hours(24) + std::chrono::seconds(1);
+    // Non-finite values are ignored: a 503 without a usable Retry-After does not block.
+    for (const char* value : {"inf", "nan", "-inf"}) {
+        AdaptiveRateLimiter limiter;
+        limiter.onResponse(CLS, 503, {{"Retry-After", value}});
+        CHECK(limiter.tryAcquire(CLS));
+    }
+    // Huge values are capped at a day instead of overflowing the conversion.
+    AdaptiveRateLimiter retry;
+    retry.onResponse(CLS, 429, {{"Retry-After", "1e300"}});
+    const auto retryWait = retry.reserve(CLS, std::chrono::hours(48));
+    CHECK(retryWait && *retryWait > std::chrono::hours(23) && *retryWait <= day);
+
+    AdaptiveRateLimiter reset;
+    reset.onResponse(CLS, 200, {{"X-RateLimit-Remaining", "0"}, {"X-RateLimit-Reset", "1e300"}});
+    const auto resetWait = reset.reserve(CLS, std::chrono::hours(48));
+    CHECK(resetWait && *resetWait > std::chrono::hours(23) && *resetWait <= day);
+}
+
+} // namespace
+
+int main() {
+    testBurstThenFailFast();
+    testReserveSchedules();
+    testRetryAfterBlocks();
+    testBackoffWithoutHeaders();
+    testFollowsServerQuota();
+    testRejectsAbsurdHeaders();
+    return TEST_RESULT;
+}
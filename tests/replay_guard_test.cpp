@@ -0,0 +1,57 @@
+#include "licensechain/replay_guard.h"
+#include "test_support.h"
+
+using namespace LicenseChain;
+using std::chrono::seconds;
+
+namespace {
+
+void testRejectsRepeats() {
+    ReplayGuard guard(seconds(60));
+    CHECK(guard.insert("evt_1"));
+    CHECK(guard.insert("evt_2"));
+    CHECK(!guard.insert("evt_1"));
+    CHECK(guard.contains("evt_2"));
+    CHECK(guard.size() == 2);
+}
+
+void testForgetsAfterWindow() {
+    ReplayGuard guard(seconds(60), 100, 4);
+    const auto start = ReplayGuard::Clock::now();
+    CHECK(guard.insert("evt_1", start));
+    CHECK(!guard.insert("evt_1", start + seconds(30)));
+    // Still inside the window, counted from the first insert.
+    CHECK(!guard.insert("evt_1", start + seconds(59)));
+    CHECK(guard.insert("evt_1", start + seconds(60 + 15 + 1)));
+}
+
+void testErase() {
+    ReplayGuard guard(seconds(60));
+    CHECK(guard.insert("evt_1"));
+    guard.erase("evt_1");
+    CHECK(!guard.contains("evt_1"));
+    CHECK(guard.insert("evt_1"));
+    guard.clear();
+    CHECK(guard.size() == 0);
+}
+
+void testFixedMemory() {
+    ReplayGuard guard(seconds(16), 10, 16);
+    const size_t memory = guard.memoryUsage();
+    const auto now = ReplayGuard::Clock::now();
+    for (int i = 0; i < 10000; ++i) guard.insert("evt_" + std::to_string(i), now);
+    // Past capacity new IDs are let through, not remembered, and counted.
+    CHECK(guard.memoryUsage() == memory);
+    CHECK(guard.size() <= guard.capacity());
+    CHECK(guard.overflows() == 10000 - guard.size());
+}
+
+} // namespace
+
+int main() {
+    testRejectsRepeats();
+    testForgetsAfterWindow();
+    testErase();
+    testFixedMemory();
+    return TEST_RESULT;
+}
@@ -0,0 +1,212 @@
+#include "licensechain/retry.h"
+#include "test_support.h"
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+
+using namespace LicenseChain;
+using std::chrono::milliseconds;
+
+namespace {
+
+RetryPolicy quickPolicy() {
+    RetryPolicy policy;
+    policy.base_delay = milliseconds(1);
+    policy.max_delay = milliseconds(5);
+    return policy;
+}
+
+template <typename Exception, typename Future>
+bool throws(Future& future) {
+    try {
+        future.get();
+    } catch (const Exception&) {
+        return true;
+    } catch (...) {
+    }
+    return false;
+}
+
+void testJitterBounds() {
+    RetryPolicy policy;
+    policy.base_delay = milliseconds(100);
+    policy.max_delay = milliseconds(1000);
+    milliseconds lowest = milliseconds::max(), highest = milliseconds::zero();
+    for (int i = 0; i < 1000; ++i) {
+        const auto first = policy.nextDelay(milliseconds(0));
+        CHECK(first >= milliseconds(100) && first <= milliseconds(300));
+        const auto next = policy.nextDelay(milliseconds(200));
+        CHECK(next >= milliseconds(100) && next <= milliseconds(600));
+        const auto capped = policy.nextDelay(milliseconds(900));
+        CHECK(capped >= milliseconds(100) && capped <= milliseconds(1000));
+        lowest = std::min(lowest, first);
+        highest = std::max(highest, first);
+    }
+    // Jittered, not a fixed delay.
+    CHECK(highest - lowest > milliseconds(100));
+
+    // A zero base delay still waits a millisecond.
+    policy.base_delay = milliseconds(0);
+    CHECK(policy.nextDelay(milliseconds(0)) >= milliseconds(1));
+}
+
+void testClassification() {
+    auto retryable = [](auto error) { return RetryPolicy::isRetryable(std::make_exception_ptr(error)); };
+    CHECK(retryable(NetworkException("reset")));
+    CHECK(retryable(ServerException("bad gateway")));
+    CHECK(retryable(RateLimitException("slow down")));
+    CHECK(retryable(LicenseChainException("TIMEOUT", "request timeout", 408)));
+    CHECK(retryable(LicenseChainException("UNAVAILABLE", "unavailable", 503)));
+    CHECK(!retryable(LicenseChainException("INTERNAL", "internal", 500)));
+    CHECK(!retryable(ValidationException("bad key")));
+    CHECK(!retryable(AuthenticationException("expired")));
+    CHECK(!retryable(NotFoundException("gone")));
+    CHECK(!retryable(ConfigurationException("bad option")));
+    CHECK(!retryable(CircuitOpenException("open")));
+    CHECK(!retryable(CancelledException("cancelled")));
+    CHECK(!retryable(DeadlineExceededException("late")));
+    CHECK(!retryable(std::runtime_error("not from the SDK")));
+    CHECK(!RetryPolicy::isRetryable(nullptr));
+}
+
+void testRetriesUntilSuccess() {
+    Executor executor(2);
+    TimerWheel timers(milliseconds(1));
+    RetryScheduler scheduler(executor, timers, quickPolicy());
+    std::atomic<int> attempts{0};
+    auto future = scheduler.submit([&] {
+        if (attempts.fetch_add(1) < 2) throw NetworkException("reset");
+        return 42;
+    });
+    CHECK(future.get() == 42);
+    CHECK(attempts == 3);
+    CHECK(scheduler.stats().retries == 2);
+}
+
+void testNonRetryableStops() {
+    Executor executor(2);
+    TimerWheel timers(milliseconds(1));
+    RetryScheduler scheduler(executor, timers, quickPolicy());
+    std::atomic<int> attempts{0};
+    auto future = scheduler.submit([&]() -> int {
+        attempts.fetch_add(1);
+        throw ValidationException("bad key");
+    });
+    CHECK(throws<ValidationException>(future));
+    CHECK(attempts == 1);
+    const auto stats = scheduler.stats();
+    CHECK(stats.not_retryable == 1);
+    CHECK(stats.retries == 0);
+}
+
+void testAttemptsExhausted() {
+    Executor executor(2);
+    TimerWheel timers(milliseconds(1));
+    RetryScheduler scheduler(executor, timers, quickPolicy());
+    std::atomic<int> attempts{0};
+    auto future = scheduler.submit([&] {
+        attempts.fetch_add(1);
+        throw NetworkException("reset");
+    });
+    CHECK(throws<NetworkException>(future));
+    CHECK(attempts == 3);
+    CHECK(scheduler.stats().attempts_exhausted == 1);
+}
+
+void testBudget() {
+    RetryBudget budget(0.1, 2.0);
+    CHECK(budget.tryWithdraw());
+    CHECK(budget.tryWithdraw());
+    CHECK(!budget.tryWithdraw());
+    // Ten first attempts earn one retry.
+    for (int i = 0; i < 10; ++i) budget.recordRequest();
+    CHECK(budget.tryWithdraw());
+    CHECK(!budget.tryWithdraw());
+    // Deposits stop at the reserve.
+    for (int i = 0; i < 1000; ++i) budget.recordRequest();
+    CHECK(budget.balance() == 2.0);
+
+    // With the budget spent, a retryable failure is not retried.
+    Executor executor(2);
+    TimerWheel timers(milliseconds(1));
+    auto empty = std::make_shared<RetryBudget>(0.0, 1.0);
+    CHECK(empty->tryWithdraw());
+    RetryScheduler scheduler(executor, timers, quickPolicy(), empty);
+    std::atomic<int> attempts{0};
+    auto future = scheduler.submit([&] {
+        attempts.fetch_add(1);
+        throw NetworkException("reset");
+    });
+    CHECK(throws<NetworkException>(future));
+    CHECK(attempts == 1);
+    CHECK(scheduler.stats().budget_exhausted == 1);
+}
+
+void testCancelledDuringBackoff() {
+    Executor executor(2);
+    TimerWheel timers(milliseconds(1));
+    RetryPolicy policy;
+    policy.base_delay = milliseconds(2000);
+    RetryScheduler scheduler(executor, timers, policy);
+    CancellationSource source;
+    std::atomic<int> attempts{0};
+    auto future = scheduler.submit([&] {
+        attempts.fetch_add(1);
+        throw NetworkException("reset");
+    }, source.token());
+    while (timers.pending() == 0) std::this_thread::sleep_for(milliseconds(1));
+    const auto start = std::chrono::steady_clock::now();
+    source.cancel();
+    CHECK(throws<CancelledException>(future));
+    CHECK(std::chrono::steady_clock::now() - start < milliseconds(500));
+    // The pending retry was dropped.
+    CHECK(timers.pending() == 0);
+    CHECK(attempts == 1);
+
+    // No retry is scheduled that could not start before the deadline.
+    CancellationSource deadline(std::chrono::steady_clock::now() + milliseconds(100));
+    auto late = scheduler.submit([] { throw NetworkException("reset"); }, deadline.token());
+    CHECK(throws<NetworkException>(late));
+}
+
+void testTimerWheel() {
+    TimerWheel timers(milliseconds(1));
+    std::atomic<int> fired{0};
+    const uint64_t first = timers.schedule(milliseconds(5), [&] { fired.fetch_add(1); });
+    const uint64_t second = timers.schedule(milliseconds(5), [&] { fired.fetch_add(10); });
+    CHECK(first != 0 && second != first);
+    CHECK(timers.cancel(second));
+    CHECK(!timers.cancel(second));
+    while (fired == 0) std::this_thread::sleep_for(milliseconds(1));
+    std::this_thread::sleep_for(milliseconds(20));
+    CHECK(fired == 1);
+    // Too late to cancel a timer that has already fired.
+    CHECK(!timers.cancel(first));
+    CHECK(timers.pending() == 0);
+
+    // Delays longer than one turn of the wheel wait for the right round.
+    TimerWheel small(milliseconds(1), 4);
+    const auto start = std::chrono::steady_clock::now();
+    std::atomic<bool> done{false};
+    small.schedule(milliseconds(30), [&] { done = true; });
+    while (!done) std::this_thread::sleep_for(milliseconds(1));
+    CHECK(std::chrono::steady_clock::now() - start >= milliseconds(25));
+
+    small.shutdown();
+    CHECK(small.schedule(milliseconds(1), [] {}) == 0);
+}
+
+} // namespace
+
+int main() {
+    testJitterBounds();
+    testClassification();
+    testRetriesUntilSuccess();
+    testNonRetryableStops();
+    testAttemptsExhausted();
+    testBudget();
+    testCancelledDuringBackoff();
+    testTimerWheel();
+    return TEST_RESULT;
+}
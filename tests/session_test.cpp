@@ -0,0 +1,208 @@
+#include "licensechain/session.h"
+#include "licensechain/exceptions.h"
+#include "test_support.h"
+#include <atomic>
+#include <thread>
+
+using namespace LicenseChain;
+using std::chrono::milliseconds;
+
+namespace {
+
+template <typename Exception>
+bool statusThrows(int status, const std::string& body = "") {
+    HttpResponse response;
+    response.status = status;
+    response.body = body;
+    try {
+        Session::throwForStatus(response);
+    } catch (const Exception&) {
+        return true;
+    } catch (...) {
+    }
+    return false;
+}
+
+template <typename Exception, typename Func>
+bool throws(Func func) {
+    try {
+        func();
+    } catch (const Exception&) {
+        return true;
+    } catch (...) {
+    }
+    return false;
+}
+
+SessionConfig testConfig() {
+    SessionConfig config;
+    config.api_key = "key";
+    config.base_url = "http://localhost";
+    config.circuit_breaker.minimum_requests = 4;
+    config.circuit_breaker.open_duration = std::chrono::minutes(1);
+    return config;
+}
+
+void testBreakerKey() {
+    const auto read = EndpointClass::Read;
+    CHECK(Session::breakerKey(read, "/v1/licenses/abc") == "1:/licenses");
+    CHECK(Session::breakerKey(read, "/v1/licenses?page=2") == "1:/licenses");
+    CHECK(Session::breakerKey(read, "/v12/licenses") == "1:/licenses");
+    CHECK(Session::breakerKey(read, "/licenses/abc") == "1:/licenses");
+    CHECK(Session::breakerKey(read, "/v1/apps") == "1:/apps");
+    // The class keeps validation apart from other traffic to the same resource.
+    CHECK(Session::breakerKey(EndpointClass::Validation, "/v1/licenses/abc/validate") == "0:/licenses");
+    // Only "v" followed by digits is a version.
+    CHECK(Session::breakerKey(read, "/versions/1") == "1:/versions");
+    CHECK(Session::breakerKey(read, "/v1") == "1:/v1");
+    CHECK(Session::breakerKey(read, "") == "1:/");
+}
+
+void testThrowForStatus() {
+    HttpResponse ok;
+    ok.status = 204;
+    Session::throwForStatus(ok);
+    CHECK(statusThrows<ValidationException>(400));
+    CHECK(statusThrows<ValidationException>(422));
+    CHECK(statusThrows<AuthenticationException>(401));
+    CHECK(statusThrows<AuthenticationException>(403));
+    CHECK(statusThrows<NotFoundException>(404));
+    CHECK(statusThrows<RateLimitException>(429));
+    CHECK(statusThrows<ServerException>(500));
+    CHECK(statusThrows<ServerException>(503));
+    HttpResponse conflict;
+    conflict.status = 409;
+    try {
+        Session::throwForStatus(conflict);
+        CHECK(false);
+    } catch (const LicenseChainException& e) {
+        CHECK(e.getStatusCode() == 409);
+        CHECK(e.getErrorCode() == "HTTP_ERROR");
+        CHECK(std::string(e.what()) == "HTTP 409");
+    }
+    conflict.body = "already exists";
+    CHECK(statusThrows<LicenseChainException>(409, "already exists"));
+    try {
+        Session::throwForStatus(conflict);
+    } catch (const LicenseChainException& e) {
+        CHECK(std::string(e.what()) == "already exists");
+    }
+}
+
+void testRequestShape() {
+    HttpRequest seen;
+    Session session(testConfig(), [&](const HttpRequest& request) {
+        seen = request;
+        HttpResponse response;
+        response.status = 200;
+        response.body = "{}";
+        return response;
+    });
+    CHECK(session.send("POST", "/v1/licenses/abc/validate", "{\"key\":1}").body == "{}");
+    CHECK(seen.url == "http://localhost/v1/licenses/abc/validate");
+    CHECK(seen.body == "{\"key\":1}");
+    CHECK(seen.authorization && *seen.authorization == "Bearer key");
+    CHECK(seen.endpoint_class == EndpointClass::Validation);
+    CHECK(seen.priority == RequestPriority::Validation);
+    CHECK(seen.headers == session.headers());
+    CHECK(seen.headers->serialized.find("User-Agent: LicenseChain-CPP-SDK") != std::string::npos);
+
+    // Non-SDK exceptions from the transport surface as network errors.
+    Session failing(testConfig(), [](const HttpRequest&) -> HttpResponse { throw std::runtime_error("refused"); });
+    CHECK(throws<NetworkException>([&] { failing.send("GET", "/v1/apps"); }));
+}
+
+void testPermitOutcomes() {
+    std::atomic<int> status{404};
+    CancellationSource cancelled;
+    Session session(testConfig(), [&](const HttpRequest& request) {
+        if (request.url.find("/cancel") != std::string::npos) {
+            std::this_thread::sleep_for(milliseconds(1));
+            cancelled.cancel();
+            request.token.throwIfCancelled();
+        }
+        std::this_thread::sleep_for(milliseconds(5));
+        HttpResponse response;
+        response.status = status;
+        return response;
+    });
+    auto& limiter = session.concurrencyLimiter();
+
+    // A 404 is a real round trip: it counts as a success and is timed.
+    CHECK(throws<NotFoundException>([&] { session.send("GET", "/v1/licenses/missing"); }));
+    auto metrics = limiter.metrics();
+    CHECK(metrics.dropped == 0);
+    CHECK(metrics.baseline_rtt >= milliseconds(5));
+
+    // Server errors mean overload: Dropped.
+    status = 503;
+    CHECK(throws<ServerException>([&] { session.send("GET", "/v1/apps"); }));
+    CHECK(limiter.metrics().dropped == 1);
+
+    // A request its caller cancelled says nothing about load: Ignored.
+    CHECK(throws<CancelledException>([&] { session.send("GET", "/v1/cancel", "", cancelled.token()); }));
+    CHECK(limiter.metrics().dropped == 1);
+    CHECK(limiter.metrics().in_flight == 0);
+}
+
+void testOpenCircuitKeepsBaseline() {
+    std::atomic<int> calls{0};
+    Session session(testConfig(), [&](const HttpRequest& request) {
+        calls.fetch_add(1);
+        std::this_thread::sleep_for(milliseconds(5));
+        HttpResponse response;
+        response.status = request.url.find("/apps") != std::string::npos ? 503 : 200;
+        return response;
+    });
+    auto& limiter = session.concurrencyLimiter();
+    CHECK(session.send("GET", "/v1/licenses").status == 200);
+    for (int i = 0; i < 4; ++i) CHECK(throws<ServerException>([&] { session.send("GET", "/v1/apps"); }));
+    const auto before = limiter.metrics();
+    CHECK(calls == 5);
+
+    // Refused without a round trip: neither timed nor counted as dropped.
+    for (int i = 0; i < 10; ++i) CHECK(throws<CircuitOpenException>([&] { session.send("GET", "/v1/apps/x"); }));
+    CHECK(calls == 5);
+    const auto after = limiter.metrics();
+    CHECK(after.baseline_rtt == before.baseline_rtt);
+    CHECK(after.short_rtt == before.short_rtt);
+    CHECK(after.dropped == before.dropped);
+    CHECK(after.baseline_rtt >= milliseconds(5));
+
+    // Other endpoints have their own breaker.
+    CHECK(session.send("GET", "/v1/licenses/abc").status == 200);
+    CHECK(session.circuitBreakers().forEndpoint("1:/apps").state() == CircuitState::Open);
+    CHECK(session.circuitBreakers().forEndpoint("1:/licenses").state() == CircuitState::Closed);
+}
+
+void testStaleFallback() {
+    std::atomic<bool> up{true};
+    SessionConfig config = testConfig();
+    config.cache_ttl = milliseconds(1);
+    Session session(config, [&](const HttpRequest&) {
+        HttpResponse response;
+        response.status = up ? 200 : 503;
+        response.body = "apps";
+        return response;
+    });
+    CHECK(session.getCached("/v1/apps") == "apps");
+    up = false;
+    std::this_thread::sleep_for(milliseconds(5));
+    // One success and three failures reach minimum_requests and open the circuit.
+    for (int i = 0; i < 3; ++i) CHECK(throws<ServerException>([&] { session.getCached("/v1/apps"); }));
+    // With the circuit open, the expired entry is served instead.
+    CHECK(session.getCached("/v1/apps") == "apps");
+    CHECK(session.metrics().stale_hits == 1);
+}
+
+} // namespace
+
+int main() {
+    testBreakerKey();
+    testThrowForStatus();
+    testRequestShape();
+    testPermitOutcomes();
+    testOpenCircuitKeepsBaseline();
+    testStaleFallback();
+    return TEST_RESULT;
+}
@@ -0,0 +1,150 @@
+#include "licensechain/tenant_client.h"
+#include "licensechain/exceptions.h"
+#include "test_support.h"
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <thread>
+
+using namespace LicenseChain;
+using std::chrono::milliseconds;
+
+namespace {
+
+template <typename Exception, typename Func>
+bool throws(Func func) {
+    try {
+        func();
+    } catch (const Exception&) {
+        return true;
+    } catch (...) {
+    }
+    return false;
+}
+
+SessionConfig testConfig() {
+    SessionConfig config;
+    config.api_key = "unused";
+    config.base_url = "http://localhost";
+    config.max_queue_wait = milliseconds(10);
+    return config;
+}
+
+// Answers with the credentials it was sent, so tests can see whose request it was.
+HttpResponse echoAuthorization(const HttpRequest& request) {
+    HttpResponse response;
+    response.status = 200;
+    response.body = request.authorization ? *request.authorization : "none";
+    return response;
+}
+
+void testRegistry() {
+    TenantClient client(testConfig(), echoAuthorization);
+    CHECK(throws<ConfigurationException>([&] { client.addTenant("", "key"); }));
+    CHECK(throws<ConfigurationException>([&] { client.addTenant("a", ""); }));
+    client.addTenant("a", "ka");
+    client.addTenant("b", "kb");
+    CHECK(client.tenantCount() == 2);
+    auto ids = client.tenantIds();
+    std::sort(ids.begin(), ids.end());
+    CHECK(ids == std::vector<std::string>({"a", "b"}));
+    CHECK(client.removeTenant("b"));
+    CHECK(!client.removeTenant("b"));
+    CHECK(!client.hasTenant("b"));
+    CHECK(throws<NotFoundException>([&] { client.send("b", "GET", "/v1/apps"); }));
+}
+
+void testCachePartitioned() {
+    std::atomic<int> calls{0};
+    TenantClient client(testConfig(), [&](const HttpRequest& request) {
+        calls.fetch_add(1);
+        return echoAuthorization(request);
+    });
+    client.addTenant("a", "ka");
+    client.addTenant("b", "kb");
+    CHECK(client.getCached("a", "/v1/apps") == "Bearer ka");
+    CHECK(client.getCached("b", "/v1/apps") == "Bearer kb");
+    CHECK(client.getCached("a", "/v1/apps") == "Bearer ka");
+    CHECK(client.getCached("b", "/v1/apps") == "Bearer kb");
+    CHECK(calls == 2);
+
+    // The signing keys are shared and fetched without credentials.
+    CHECK(client.jwks() == "none");
+    CHECK(client.jwks() == "none");
+    CHECK(calls == 3);
+    CHECK(client.session().metrics().cache_hits == 3);
+}
+
+void testRateLimitsPerTenant() {
+    std::atomic<int> calls{0};
+    TenantClient client(testConfig(), [&](const HttpRequest& request) {
+        calls.fetch_add(1);
+        HttpResponse response = echoAuthorization(request);
+        if (response.body == "Bearer ka") {
+            response.status = 429;
+            response.headers["Retry-After"] = "60";
+        }
+        return response;
+    });
+    client.addTenant("a", "ka");
+    client.addTenant("b", "kb");
+    CHECK(throws<RateLimitException>([&] { client.send("a", "GET", "/v1/apps"); }));
+    CHECK(calls == 1);
+    // Tenant a now waits out its Retry-After locally; b is unaffected.
+    CHECK(throws<RateLimitException>([&] { client.send("a", "GET", "/v1/apps"); }));
+    CHECK(calls == 1);
+    for (int i = 0; i < 5; ++i) CHECK(client.send("b", "GET", "/v1/apps").body == "Bearer kb");
+    CHECK(client.rateLimiterStats("a", EndpointClass::Read).rate_limited == 1);
+    CHECK(client.rateLimiterStats("b", EndpointClass::Read).rate_limited == 0);
+    CHECK(client.rateLimiterStats("b", EndpointClass::Read).granted == 5);
+
+    // A new key takes effect at once but keeps the tenant's learned limits.
+    client.addTenant("a", "ka2");
+    CHECK(client.tenantCount() == 2);
+    CHECK(client.rateLimiterStats("a", EndpointClass::Read).rate_limited == 1);
+    CHECK(throws<RateLimitException>([&] { client.send("a", "GET", "/v1/apps"); }));
+    CHECK(calls == 6);
+}
+
+void testKeySwap() {
+    TenantClient client(testConfig(), echoAuthorization);
+    client.addTenant("a", "ka");
+    CHECK(client.send("a", "GET", "/v1/apps").body == "Bearer ka");
+    client.addTenant("a", "ka2");
+    CHECK(client.send("a", "GET", "/v1/apps").body == "Bearer ka2");
+}
+
+void testRemoveDuringRequest() {
+    std::promise<void> entered;
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    TenantClient client(testConfig(), [&](const HttpRequest& request) {
+        if (request.authorization && *request.authorization == "Bearer kc") {
+            entered.set_value();
+            released.wait();
+        }
+        return echoAuthorization(request);
+    });
+    client.addTenant("c", "kc");
+    auto inFlight = std::async(std::launch::async, [&] { return client.send("c", "GET", "/v1/apps"); });
+    entered.get_future().wait();
+    CHECK(client.removeTenant("c"));
+    CHECK(!client.hasTenant("c"));
+    release.set_value();
+    // The request keeps its tenant alive and finishes with its credentials.
+    const HttpResponse response = inFlight.get();
+    CHECK(response.status == 200);
+    CHECK(response.body == "Bearer kc");
+    CHECK(throws<NotFoundException>([&] { client.send("c", "GET", "/v1/apps"); }));
+}
+
+} // namespace
+
+int main() {
+    testRegistry();
+    testCachePartitioned();
+    testRateLimitsPerTenant();
+    testKeySwap();
+    testRemoveDuringRequest();
+    return TEST_RESULT;
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <random>
+#include <string>
+
+// Minimal checks for the test executables. A failed CHECK is reported and
+// counted; main() returns TEST_RESULT so ctest sees the failure.
+namespace LicenseChainTest {
+
+inline int failures = 0;
+
+inline void report(const char* file, int line, const char* expression) {
+    std::fprintf(stderr, "%s:%d: CHECK failed: %s\n", file, line, expression);
+    ++failures;
+}
+
+// Fresh, empty directory under the system temp directory, removed on scope exit.
+class TempDirectory {
+public:
+    explicit TempDirectory(const std::string& name) {
+        std::random_device random;
+        path_ = (std::filesystem::temp_directory_path() / (name + "-" + std::to_string(random()))).string();
+        std::filesystem::remove_all(path_);
+    }
+    ~TempDirectory() {
+        std::error_code ec;
+        std::filesystem::remove_all(path_, ec);
+    }
+    TempDirectory(const TempDirectory&) = delete;
+    TempDirectory& operator=(const TempDirectory&) = delete;
+
+    const std::string& path() const { return path_; }
+
+private:
+    std::string path_;
+};
+
+// Benchmarks run a short pass when given --quick, as they do under ctest.
+inline bool quickRun(int argc, char** argv) {
+    return argc > 1 && std::string(argv[1]) == "--quick";
+}
+
+template <typename Func>
+double secondsFor(Func&& func) {
+    const auto start = std::chrono::steady_clock::now();
+    func();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace LicenseChainTest
+
+#define CHECK(expression) \
+    ((expression) ? (void)0 : LicenseChainTest::report(__FILE__, __LINE__, #expression))
+
+#define TEST_RESULT (LicenseChainTest::failures == 0 ? 0 : 1)
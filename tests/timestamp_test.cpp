@@ -0,0 +1,63 @@
+#include "licensechain/utils.h"
+#include "test_support.h"
+
+using namespace LicenseChain;
+using std::chrono::system_clock;
+
+namespace {
+
+system_clock::time_point at(int64_t seconds, int64_t millis = 0) {
+    return system_clock::time_point(std::chrono::duration_cast<system_clock::duration>(
+        std::chrono::seconds(seconds) + std::chrono::milliseconds(millis)));
+}
+
+std::string format(system_clock::time_point time) {
+    char buffer[Utils::TIMESTAMP_BUFFER_SIZE];
+    const auto result = Utils::formatTimestamp(buffer, buffer + sizeof(buffer), time);
+    CHECK(result.ec == std::errc());
+    return std::string(buffer, result.ptr);
+}
+
+void testTimestampParse() {
+    system_clock::time_point t;
+    CHECK(Utils::tryParseTimestamp("2026-10-18T12:34:56Z", t) && t == at(1792326896));
+    CHECK(Utils::tryParseTimestamp("2026-10-18T12:34:56", t) && t == at(1792326896));
+    CHECK(Utils::tryParseTimestamp("2026-10-18t12:34:56z", t) && t == at(1792326896));
+    CHECK(Utils::tryParseTimestamp("2026-10-18T14:34:56.789+02:00", t) && t == at(1792326896, 789));
+    CHECK(Utils::tryParseTimestamp("2026-10-18T07:04:56.5-0530", t) && t == at(1792326896, 500));
+    CHECK(Utils::tryParseTimestamp("2000-02-29T23:59:59Z", t) && t == at(951868799));
+    CHECK(Utils::tryParseTimestamp("1970-01-01", t) && t == at(0));
+    CHECK(Utils::tryParseTimestamp("2026-10-18T12:34:56.123456789Z", t) &&
+          t - at(1792326896, 123) < std::chrono::milliseconds(1));
+
+    for (const char* bad : {"", "2026-10-18T", "2026-13-01T00:00:00Z", "2026-02-29T00:00:00Z",
+                            "2026-10-18T24:00:00Z", "2026-10-18T12:34:56.Z", "2026-10-18T12:34:56+2",
+                            "2026-10-18T12:34:56Zjunk", "26-10-18T12:34:56Z"}) {
+        CHECK(!Utils::tryParseTimestamp(bad, t));
+    }
+}
+
+void testTimestampRoundTrip() {
+    CHECK(format(at(1792326896, 789)) == "2026-10-18T12:34:56.789Z");
+    CHECK(format(at(0)) == "1970-01-01T00:00:00.000Z");
+    CHECK(Utils::formatTimestamp(at(951868799)) == "2000-02-29T23:59:59.000Z");
+
+    // Every few days across leap years and century boundaries.
+    for (int64_t seconds = -86400LL * 365 * 2; seconds < 86400LL * 365 * 140; seconds += 86400LL * 3 + 3661) {
+        const auto time = at(seconds, seconds % 1000 < 0 ? -(seconds % 1000) : seconds % 1000);
+        system_clock::time_point parsed;
+        CHECK(Utils::tryParseTimestamp(format(time), parsed));
+        CHECK(parsed == time);
+    }
+
+    char small[Utils::TIMESTAMP_BUFFER_SIZE - 1];
+    CHECK(Utils::formatTimestamp(small, small + sizeof(small), at(0)).ec == std::errc::value_too_large);
+}
+
+} // namespace
+
+int main() {
+    testTimestampParse();
+    testTimestampRoundTrip();
+    return TEST_RESULT;
+}
@@ -0,0 +1,200 @@
+#include "licensechain/token_manager.h"
+#include "licensechain/exceptions.h"
+#include "licensechain/session.h"
+#include "test_support.h"
+#include <atomic>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace LicenseChain;
+using std::chrono::milliseconds;
+
+namespace {
+
+AuthToken token(const std::string& access, std::chrono::system_clock::duration lifetime = std::chrono::hours(1)) {
+    return AuthToken{access, "refresh-" + access, std::chrono::system_clock::now() + lifetime};
+}
+
+TokenRefreshOptions quickRetry() {
+    TokenRefreshOptions options;
+    options.retry.base_delay = milliseconds(1);
+    options.retry.max_delay = milliseconds(5);
+    return options;
+}
+
+bool waitForGeneration(const TokenManager& tokens, uint64_t generation) {
+    const auto giveUp = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (tokens.stats().generation < generation) {
+        if (std::chrono::steady_clock::now() > giveUp) return false;
+        std::this_thread::sleep_for(milliseconds(1));
+    }
+    return true;
+}
+
+void testConcurrentRefreshCoalesces() {
+    Executor executor(2);
+    TimerWheel timers;
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    std::atomic<int> calls{0};
+    TokenManager tokens(executor, timers, [&](const std::string& refreshToken) {
+        calls.fetch_add(1);
+        CHECK(refreshToken == "refresh-t1");
+        released.wait();
+        return token("t2");
+    });
+    CHECK(!tokens.header());
+    tokens.setToken(token("t1"));
+    CHECK(tokens.header()->value == "Bearer t1");
+
+    std::vector<std::shared_future<std::shared_ptr<const AuthHeader>>> waiting;
+    std::vector<std::thread> callers;
+    std::mutex mutex;
+    for (int i = 0; i < 8; ++i) {
+        callers.emplace_back([&] {
+            auto future = tokens.refresh();
+            std::lock_guard<std::mutex> lock(mutex);
+            waiting.push_back(future);
+        });
+    }
+    for (auto& caller : callers) caller.join();
+    // Request threads keep the old header while the refresh runs.
+    CHECK(tokens.header()->generation == 1);
+    release.set_value();
+    for (auto& future : waiting) CHECK(future.get()->value == "Bearer t2");
+    CHECK(calls == 1);
+    const auto stats = tokens.stats();
+    CHECK(stats.generation == 2);
+    CHECK(stats.refreshes == 1);
+    CHECK(stats.coalesced == 7);
+}
+
+void testStaleGenerationShortcut() {
+    Executor executor(2);
+    TimerWheel timers;
+    std::atomic<int> calls{0};
+    TokenManager tokens(executor, timers, [&](const std::string&) {
+        return token("t" + std::to_string(calls.fetch_add(1) + 2));
+    });
+    tokens.setToken(token("t1"));
+    CHECK(tokens.refresh(1).get()->generation == 2);
+    // A caller still holding generation 1 picks up the newer header.
+    const auto shortcut = tokens.refresh(1).get();
+    CHECK(shortcut->generation == 2 && shortcut->value == "Bearer t2");
+    CHECK(calls == 1);
+    // Rejecting the current header refreshes again.
+    CHECK(tokens.refresh(2).get()->value == "Bearer t3");
+    CHECK(calls == 2);
+}
+
+void testRetryableFailureRescheduled() {
+    Executor executor(2);
+    TimerWheel timers(milliseconds(1));
+    std::atomic<int> calls{0};
+    TokenManager tokens(executor, timers, [&](const std::string&) {
+        if (calls.fetch_add(1) == 0) throw NetworkException("connection reset");
+        return token("t2");
+    }, quickRetry());
+    tokens.setToken(token("t1"));
+    bool threw = false;
+    try {
+        tokens.refresh().get();
+    } catch (const NetworkException&) {
+        threw = true;
+    }
+    CHECK(threw);
+    // The failure is retried on the timer wheel without another caller.
+    CHECK(waitForGeneration(tokens, 2));
+    CHECK(tokens.header()->value == "Bearer t2");
+    const auto stats = tokens.stats();
+    CHECK(stats.failures == 1);
+    CHECK(stats.refreshes == 1);
+}
+
+void testRejectedRefreshNotRetried() {
+    Executor executor(2);
+    TimerWheel timers(milliseconds(1));
+    std::atomic<int> calls{0};
+    TokenManager tokens(executor, timers, [&](const std::string&) -> AuthToken {
+        calls.fetch_add(1);
+        throw AuthenticationException("refresh token revoked");
+    }, quickRetry());
+    tokens.setToken(token("t1"));
+    bool threw = false;
+    try {
+        tokens.refresh().get();
+    } catch (const AuthenticationException&) {
+        threw = true;
+    }
+    CHECK(threw);
+    std::this_thread::sleep_for(milliseconds(50));
+    CHECK(calls == 1);
+    CHECK(tokens.header()->value == "Bearer t1");
+}
+
+void testRefreshedBeforeExpiry() {
+    Executor executor(2);
+    TimerWheel timers(milliseconds(1));
+    TokenRefreshOptions options;
+    options.refresh_at = 0.5;
+    options.min_margin = milliseconds(0);
+    TokenManager tokens(executor, timers, [](const std::string&) { return token("t2"); }, options);
+    tokens.setToken(token("t1", std::chrono::milliseconds(200)));
+    CHECK(waitForGeneration(tokens, 2));
+    CHECK(tokens.header()->expires_at > std::chrono::steady_clock::now() + std::chrono::minutes(59));
+}
+
+void testSessionRetriesAfter401() {
+    SessionConfig config;
+    config.base_url = "http://localhost";
+    std::atomic<int> calls{0};
+    std::atomic<bool> accept{true};
+    Session session(config, [&](const HttpRequest& request) {
+        calls.fetch_add(1);
+        HttpResponse response;
+        response.status = accept && request.authorization && *request.authorization == "Bearer t2" ? 200 : 401;
+        return response;
+    });
+    std::atomic<int> refreshes{0};
+    auto tokens = std::make_shared<TokenManager>(session.executor(), session.timers(), [&](const std::string&) {
+        refreshes.fetch_add(1);
+        return token("t2");
+    });
+    tokens->setToken(token("t1"));
+    session.setTokenManager(tokens);
+
+    CHECK(session.send("GET", "/v1/apps").status == 200);
+    CHECK(calls == 2);
+    CHECK(refreshes == 1);
+    // The refreshed header is used directly from then on.
+    CHECK(session.send("GET", "/v1/apps").status == 200);
+    CHECK(calls == 3);
+
+    // A 401 that survives the refresh is not retried again.
+    accept = false;
+    calls = 0;
+    bool threw = false;
+    try {
+        session.send("GET", "/v1/apps");
+    } catch (const AuthenticationException&) {
+        threw = true;
+    }
+    CHECK(threw);
+    CHECK(calls == 2);
+    session.setTokenManager(nullptr);
+}
+
+} // namespace
+
+int main() {
+    testConcurrentRefreshCoalesces();
+    testStaleGenerationShortcut();
+    testRetryableFailureRescheduled();
+    testRejectedRefreshNotRetried();
+    testRefreshedBeforeExpiry();
+    testSessionRetriesAfter401();
+    return TEST_RESULT;
+}
@@ -0,0 +1,183 @@
+#include "licensechain/webhook_handler.h"
+#include "licensechain/utils.h"
+#include "test_support.h"
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+
+using namespace LicenseChain;
+using LicenseChainTest::TempDirectory;
+
+namespace {
+
+const std::string SECRET = "whsec_test";
+
+std::string unixNow(int offsetSeconds = 0) {
+    using namespace std::chrono;
+    return std::to_string(duration_cast<seconds>(system_clock::now().time_since_epoch()).count() + offsetSeconds);
+}
+
+std::string event(const std::string& id, const std::string& type, const std::string& timestamp) {
+    return "{\"id\":\"" + id + "\",\"type\":\"" + type + "\",\"timestamp\":\"" + timestamp +
+           "\",\"data\":{\"license_id\":\"lic_1\"}}";
+}
+
+WebhookResult receive(WebhookHandler& handler, const std::string& payload) {
+    return handler.receiveWebhook(payload, WebhookHandler::createSignature(payload, SECRET), unixNow());
+}
+
+bool process(WebhookHandler& handler, const std::string& payload) {
+    return handler.processWebhook(payload, WebhookHandler::createSignature(payload, SECRET), unixNow());
+}
+
+void testDispatch() {
+    WebhookHandler handler(SECRET);
+    std::atomic<int> created{0}, custom{0}, views{0};
+    handler.onLicenseCreated([&](const WebhookEvent& e) { created += e.type == "license.created"; });
+    handler.onEventView("license.created", [&](const WebhookEventView& e) { views += e.id == "evt_1"; });
+    handler.onEventView("acme.sync", [&](const WebhookEventView& e) { custom += e.id == "evt_2"; });
+    CHECK(process(handler, event("evt_1", "license.created", unixNow())));
+    CHECK(process(handler, event("evt_2", "acme.sync", unixNow())));
+    // Types without callbacks, known or not, are accepted and ignored.
+    CHECK(process(handler, event("evt_3", "license.updated", unixNow())));
+    CHECK(process(handler, event("evt_4", "acme.unknown", unixNow())));
+    CHECK(created == 1 && views == 1 && custom == 1);
+}
+
+void testRejects() {
+    WebhookHandler handler(SECRET);
+    const std::string payload = event("evt_1", "license.created", unixNow());
+    CHECK(!handler.processWebhook(payload, WebhookHandler::createSignature(payload, "other"), unixNow()));
+    CHECK(!handler.processWebhook(payload, WebhookHandler::createSignature(payload, SECRET), unixNow(-3600)));
+    CHECK(!process(handler, "not json"));
+}
+
+void testReplayProtection() {
+    WebhookHandler handler(SECRET);
+    handler.enableReplayProtection();
+    const std::string payload = event("evt_1", "license.created", unixNow());
+    const std::string signature = WebhookHandler::createSignature(payload, SECRET);
+    CHECK(handler.receiveWebhook(payload, signature, unixNow()) == WebhookResult::Accepted);
+    CHECK(handler.receiveWebhook(payload, signature, unixNow()) == WebhookResult::Duplicate);
+    handler.disableReplayProtection();
+    CHECK(handler.receiveWebhook(payload, signature, unixNow()) == WebhookResult::Accepted);
+}
+
+void testSignedTimestamp() {
+    WebhookHandler handler(SECRET);
+    const std::string fresh = event("evt_0", "license.created", unixNow());
+    const std::string signature = WebhookHandler::createSignature(fresh, SECRET);
+    CHECK(handler.receiveWebhook(fresh, signature, "") == WebhookResult::InvalidTimestamp);
+    CHECK(!handler.verifySignature(fresh, signature, ""));
+    CHECK(handler.verifySignature(fresh, signature, unixNow()));
+
+    // A captured delivery replayed later: only the signed payload time can
+    // refuse it, whatever the header says.
+    CHECK(receive(handler, event("evt_1", "license.created", unixNow(-3600))) == WebhookResult::InvalidTimestamp);
+    const std::string untimed = "{\"id\":\"evt_2\",\"type\":\"license.created\",\"data\":{}}";
+    CHECK(receive(handler, untimed) == WebhookResult::InvalidTimestamp);
+    CHECK(receive(handler, event("evt_3", "license.created", "2020-01-01T00:00:00Z")) ==
+          WebhookResult::InvalidTimestamp);
+    CHECK(receive(handler, event("evt_4", "license.created", unixNow())) == WebhookResult::Accepted);
+
+    // The same holds with replay protection on.
+    handler.enableReplayProtection();
+    CHECK(receive(handler, event("evt_5", "license.created", unixNow(-3600))) == WebhookResult::InvalidTimestamp);
+    CHECK(receive(handler, event("evt_6", "license.created", unixNow())) == WebhookResult::Accepted);
+}
+
+void testInboxReplay() {
+    TempDirectory dir("handler-inbox");
+    {
+        // Appended but never acknowledged, as if the process died mid-dispatch.
+        WebhookInbox inbox(dir.path());
+        const std::string payload = event("evt_1", "license.created", unixNow());
+        inbox.append(payload, WebhookHandler::createSignature(payload, SECRET));
+    }
+    WebhookHandler handler(SECRET);
+    int created = 0;
+    handler.onLicenseCreated([&](const WebhookEvent&) { ++created; });
+    handler.setInbox(std::make_shared<WebhookInbox>(dir.path()));
+    CHECK(handler.replayInbox() == 1);
+    CHECK(created == 1);
+    CHECK(handler.getInbox()->pendingCount() == 0);
+
+    // Deliveries received with an inbox attached are acknowledged once handled.
+    const std::string payload = event("evt_2", "license.created", unixNow());
+    CHECK(handler.receiveWebhook(payload, WebhookHandler::createSignature(payload, SECRET), unixNow()) ==
+          WebhookResult::Accepted);
+    CHECK(created == 2);
+    CHECK(handler.getInbox()->pendingCount() == 0);
+}
+
+void testPoisonEntryDeadLettered() {
+    TempDirectory dir("handler-poison");
+    {
+        WebhookHandler handler(SECRET);
+        handler.setInbox(std::make_shared<WebhookInbox>(dir.path()));
+        handler.onEvent("acme.poison", [](const WebhookEvent&) { throw std::runtime_error("boom"); });
+        // A synchronous callback's exception reaches the caller; the entry stays in the inbox.
+        bool threw = false;
+        try {
+            receive(handler, event("evt_1", "acme.poison", unixNow()));
+        } catch (const std::runtime_error&) {
+            threw = true;
+        }
+        CHECK(threw);
+        CHECK(receive(handler, event("evt_2", "acme.ok", unixNow())) == WebhookResult::Accepted);
+        CHECK(handler.getInbox()->pendingCount() == 1);
+    }
+
+    // Each restart replays the poison entry once more, until it is given up on.
+    int deadLettered = 0;
+    uint32_t attempts = 0;
+    for (int restart = 0; restart < 3; ++restart) {
+        WebhookHandler handler(SECRET);
+        handler.setInbox(std::make_shared<WebhookInbox>(dir.path()));
+        handler.setMaxReplayAttempts(3);
+        handler.onEvent("acme.poison", [](const WebhookEvent&) { throw std::runtime_error("boom"); });
+        handler.onDeadLetter([&](const WebhookInbox::Entry& entry) {
+            ++deadLettered;
+            attempts = entry.attempts;
+        });
+        handler.replayInbox();
+        CHECK(handler.getInbox()->pendingCount() == (restart < 2 ? 1u : 0u));
+    }
+    CHECK(deadLettered == 1);
+    CHECK(attempts == 3);
+}
+
+void testLoadShedding() {
+    WebhookHandler handler(SECRET);
+    LoadSheddingOptions options;
+    options.max_in_flight = 2;
+    handler.enableLoadShedding(options);
+    std::atomic<bool> release{false};
+    auto slow = [&](const WebhookEvent&) {
+        while (!release.load()) std::this_thread::yield();
+    };
+    handler.onEvent("acme.slow", slow);
+    handler.onLicenseRevoked(slow);
+    handler.enableAsyncDispatch(1, 0);
+    CHECK(receive(handler, event("evt_1", "acme.slow", unixNow())) == WebhookResult::Accepted);
+    // Pressure is now 0.5: Low (webhook.*) is shed, Critical still gets in.
+    CHECK(receive(handler, event("evt_2", "webhook.updated", unixNow())) == WebhookResult::Shed);
+    CHECK(receive(handler, event("evt_3", "license.revoked", unixNow())) == WebhookResult::Accepted);
+    CHECK(receive(handler, event("evt_4", "license.revoked", unixNow())) == WebhookResult::Shed);
+    release = true;
+    handler.disableAsyncDispatch();
+    CHECK(handler.getLoadSheddingMetrics().shed[static_cast<size_t>(EventPriority::Low)] == 1);
+}
+
+} // namespace
+
+int main() {
+    testDispatch();
+    testRejects();
+    testReplayProtection();
+    testSignedTimestamp();
+    testInboxReplay();
+    testPoisonEntryDeadLettered();
+    testLoadShedding();
+    return TEST_RESULT;
+}
@@ -0,0 +1,129 @@
+#include "licensechain/webhook_inbox.h"
+#include "test_support.h"
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <thread>
+#include <vector>
+
+using namespace LicenseChain;
+using LicenseChainTest::TempDirectory;
+
+namespace {
+
+std::vector<std::filesystem::path> segments(const std::string& directory) {
+    std::vector<std::filesystem::path> files;
+    for (const auto& entry : std::filesystem::directory_iterator(directory)) files.push_back(entry.path());
+    std::sort(files.begin(), files.end());
+    return files;
+}
+
+void testRecoversUnacknowledged() {
+    TempDirectory dir("inbox-recover");
+    uint64_t first, second, third;
+    {
+        WebhookInbox inbox(dir.path());
+        first = inbox.append("{\"id\":\"1\"}", "sig1");
+        second = inbox.append("{\"id\":\"2\"}", "sig2");
+        third = inbox.append("{\"id\":\"3\"}", "sig3");
+        inbox.acknowledge(second);
+        CHECK(inbox.pendingCount() == 2);
+    }
+    // Reopened as after a crash: what was not acknowledged comes back in order.
+    WebhookInbox inbox(dir.path());
+    const auto pending = inbox.pending();
+    CHECK(pending.size() == 2);
+    CHECK(pending.size() == 2 && pending[0].sequence == first && pending[0].payload == "{\"id\":\"1\"}" &&
+          pending[0].signature == "sig1");
+    CHECK(pending.size() == 2 && pending[1].sequence == third && pending[1].signature == "sig3");
+    CHECK(inbox.append("{\"id\":\"4\"}", "sig4") > third);
+}
+
+void testTornTail() {
+    TempDirectory dir("inbox-torn");
+    {
+        WebhookInbox inbox(dir.path(), 4096);
+        inbox.append("{\"id\":\"kept\"}", "a");
+        inbox.append("{\"id\":\"torn\"}", "b");
+    }
+    // Corrupt the last record's body, as a crash mid-write would leave it.
+    const auto files = segments(dir.path());
+    CHECK(files.size() == 1);
+    std::string bytes;
+    {
+        std::ifstream in(files.back(), std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(in), {});
+    }
+    const size_t at = bytes.find("torn");
+    CHECK(at != std::string::npos);
+    bytes[at] = 'X';
+    {
+        std::ofstream out(files.back(), std::ios::binary | std::ios::trunc);
+        out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    }
+
+    {
+        WebhookInbox inbox(dir.path(), 4096);
+        const auto pending = inbox.pending();
+        CHECK(pending.size() == 1 && pending[0].payload == "{\"id\":\"kept\"}");
+        // Appending after the torn record must not resurrect it.
+        inbox.append("{\"id\":\"after\"}", "c");
+    }
+    WebhookInbox inbox(dir.path(), 4096);
+    const auto pending = inbox.pending();
+    CHECK(pending.size() == 2);
+    CHECK(pending.size() == 2 && pending[1].payload == "{\"id\":\"after\"}");
+}
+
+void testAttemptsSurviveRestart() {
+    TempDirectory dir("inbox-attempts");
+    uint64_t sequence;
+    {
+        WebhookInbox inbox(dir.path());
+        sequence = inbox.append("{}", "s");
+        CHECK(inbox.recordAttempt(sequence) == 1);
+        CHECK(inbox.recordAttempt(sequence) == 2);
+    }
+    WebhookInbox inbox(dir.path());
+    const auto pending = inbox.pending();
+    CHECK(pending.size() == 1 && pending[0].attempts == 2);
+    CHECK(inbox.recordAttempt(sequence) == 3);
+}
+
+void testSegmentsReclaimed() {
+    TempDirectory dir("inbox-rotate");
+    WebhookInbox inbox(dir.path(), 4096);
+    const std::string payload(1000, 'p');
+    std::vector<uint64_t> sequences;
+    for (int i = 0; i < 20; ++i) sequences.push_back(inbox.append(payload, "sig"));
+    CHECK(inbox.segmentCount() > 1);
+    for (const uint64_t sequence : sequences) inbox.acknowledge(sequence);
+    CHECK(inbox.pendingCount() == 0);
+    CHECK(inbox.segmentCount() == 1);
+    CHECK(segments(dir.path()).size() == 1);
+}
+
+void testConcurrentAppendsShareCommits() {
+    TempDirectory dir("inbox-group");
+    WebhookInbox inbox(dir.path());
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; ++t) {
+        threads.emplace_back([&inbox] {
+            for (int i = 0; i < 200; ++i) inbox.append("{\"id\":\"x\"}", "sig");
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    CHECK(inbox.pendingCount() == 1600);
+    CHECK(inbox.commits() <= 1600);
+}
+
+} // namespace
+
+int main() {
+    testRecoversUnacknowledged();
+    testTornTail();
+    testAttemptsSurviveRestart();
+    testSegmentsReclaimed();
+    testConcurrentAppendsShareCommits();
+    return TEST_RESULT;
+}
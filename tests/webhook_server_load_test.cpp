@@ -0,0 +1,157 @@
+// Load test for WebhookServer: keep-alive clients on localhost post signed
+// deliveries, pipelined, and every one must be answered 200 and dispatched.
+//
+//   webhook_server_load_test [clients] [requests per client] [pipeline depth]
+
+#include "licensechain/webhook_handler.h"
+#include "licensechain/webhook_server.h"
+#include "test_support.h"
+#include <arpa/inet.h>
+#include <atomic>
+#include <cstdlib>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+using namespace LicenseChain;
+
+namespace {
+
+const std::string SECRET = "whsec_load";
+
+int connectTo(uint16_t port) {
+    const int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (fd < 0 || ::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        if (fd >= 0) ::close(fd);
+        return -1;
+    }
+    const int one = 1;
+    ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    return fd;
+}
+
+bool sendAll(int fd, const std::string& data) {
+    size_t sent = 0;
+    while (sent < data.size()) {
+        const ssize_t n = ::send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+        if (n <= 0) return false;
+        sent += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+std::string request(const std::string& id) {
+    const std::string now = std::to_string(
+        std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count());
+    const std::string body = "{\"id\":\"" + id + "\",\"type\":\"license.created\",\"timestamp\":" + now +
+                             ",\"data\":{\"license_id\":\"" + id + "\"}}";
+    return "POST /webhook HTTP/1.1\r\nHost: localhost\r\nContent-Type: application/json\r\n"
+           "X-LicenseChain-Signature: " + WebhookHandler::createSignature(body, SECRET) + "\r\n"
+           "X-LicenseChain-Timestamp: " + now + "\r\n"
+           "Content-Length: " + std::to_string(body.size()) + "\r\n\r\n" + body;
+}
+
+// Sends `requests` deliveries, `depth` at a time, and counts 200 responses.
+size_t runClient(uint16_t port, int client, size_t requests, size_t depth) {
+    const int fd = connectTo(port);
+    if (fd < 0) return 0;
+    std::vector<std::string> batch;
+    std::string pending;
+    size_t ok = 0;
+    char buffer[16 * 1024];
+    for (size_t done = 0; done < requests;) {
+        const size_t count = std::min(depth, requests - done);
+        std::string out;
+        for (size_t i = 0; i < count; ++i) out += request("evt_" + std::to_string(client) + "_" + std::to_string(done + i));
+        if (!sendAll(fd, out)) break;
+        size_t answered = 0;
+        while (answered < count) {
+            size_t end;
+            while (answered < count && (end = pending.find("\r\n\r\n")) != std::string::npos) {
+                ok += pending.compare(0, 12, "HTTP/1.1 200") == 0;
+                pending.erase(0, end + 4);
+                ++answered;
+            }
+            if (answered == count) break;
+            const ssize_t n = ::recv(fd, buffer, sizeof(buffer), 0);
+            if (n <= 0) {
+                ::close(fd);
+                return ok;
+            }
+            pending.append(buffer, static_cast<size_t>(n));
+        }
+        done += count;
+    }
+    ::close(fd);
+    return ok;
+}
+
+void testConnectionLimit() {
+    WebhookHandler handler(SECRET);
+    WebhookServerConfig config;
+    config.bind_address = "127.0.0.1";
+    config.port = 0;
+    config.max_connections = 2;
+    WebhookServer server(handler, config);
+    server.start();
+
+    const int a = connectTo(server.port());
+    const int b = connectTo(server.port());
+    CHECK(runClient(server.port(), 0, 1, 1) == 0);   // a third connection is closed on accept
+    CHECK(sendAll(a, request("evt_a")));
+    char buffer[256];
+    CHECK(::recv(a, buffer, sizeof(buffer), 0) > 0 && std::string(buffer, 12) == "HTTP/1.1 200");
+    ::close(a);
+    ::close(b);
+    server.stop();
+    CHECK(server.stats().refused_connections >= 1);
+}
+
+void testLoad(size_t clients, size_t requests, size_t depth) {
+    WebhookHandler handler(SECRET);
+    std::atomic<size_t> delivered{0};
+    handler.onLicenseCreated([&](const WebhookEvent&) { delivered.fetch_add(1, std::memory_order_relaxed); });
+
+    WebhookServerConfig config;
+    config.bind_address = "127.0.0.1";
+    config.port = 0;
+    config.threads = 2;
+    WebhookServer server(handler, config);
+    server.start();
+
+    std::atomic<size_t> ok{0};
+    const double seconds = LicenseChainTest::secondsFor([&] {
+        std::vector<std::thread> threads;
+        for (size_t c = 0; c < clients; ++c) {
+            threads.emplace_back([&, c] { ok += runClient(server.port(), static_cast<int>(c), requests, depth); });
+        }
+        for (auto& thread : threads) thread.join();
+    });
+    server.stop();
+
+    const size_t total = clients * requests;
+    std::printf("%zu clients x %zu requests, pipeline depth %zu: %.0f requests/s\n", clients, requests, depth,
+                static_cast<double>(total) / seconds);
+    CHECK(ok == total);
+    CHECK(delivered == total);
+    const auto stats = server.stats();
+    CHECK(stats.requests == total && stats.accepted_events == total && stats.rejected_events == 0);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const size_t clients = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 16;
+    const size_t requests = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 2000;
+    const size_t depth = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 8;
+    testConnectionLimit();
+    testLoad(clients, requests, depth);
+    return TEST_RESULT;
+}